@@ -119,12 +119,12 @@ int radians_to_sicher_angle(double radians)
 //}
 
 void rotate_point_by_axis(
-  std::vector<double> &point_arg,
+  vector_3d &point_arg,
   double angle_sin,
   double angle_cos,
   rotation_axis axis)
 {
-  std::vector<double> point_orig = point_arg;
+  vector_3d point_orig = point_arg;
 
   const std::vector<std::size_t> &axes =
     axes_by_plane_continuous[static_cast<std::size_t>(axis)];
@@ -134,7 +134,7 @@ void rotate_point_by_axis(
     angle_sin * point_orig[axes[0]] + angle_cos * point_orig[axes[1]];
 }
 
-void rotate_point_by_axis(std::vector<double> &point_arg,
+void rotate_point_by_axis(vector_3d &point_arg,
                           double angle,
                           rotation_axis axis)
 {
@@ -151,7 +151,25 @@ void rotate_point_by_axis(std::vector<double> &point_arg,
 
 
 
-std::vector<double> vector_scale(double norm, const std::vector<double> &vec)
+vector_3d vector_3d_filled(double value)
+{
+  vector_3d ret;
+  ret.fill(value);
+  return ret;
+}
+
+
+
+vector_2d vector_2d_filled(double value)
+{
+  vector_2d ret;
+  ret.fill(value);
+  return ret;
+}
+
+
+
+vector_3d vector_scale(double norm, const vector_3d &vec)
 {
   double vec_length = vector_length(vec);
   double s;
@@ -164,7 +182,7 @@ std::vector<double> vector_scale(double norm, const std::vector<double> &vec)
     s = norm / vec_length;
   }
 
-  std::vector<double> ret(axes_num, 0.0);
+  vector_3d ret = vector_3d_filled(0.0);
   for(std::size_t cur_coord = 0; cur_coord < axes_num; ++cur_coord)
   {
     ret[cur_coord] = vec[cur_coord] * s;
@@ -175,7 +193,7 @@ std::vector<double> vector_scale(double norm, const std::vector<double> &vec)
 
 
 
-void vector_scale_self(double norm, std::vector<double> &vec)
+void vector_scale_self(double norm, vector_3d &vec)
 {
   double vec_length = vector_length(vec);
   double s;
@@ -196,7 +214,7 @@ void vector_scale_self(double norm, std::vector<double> &vec)
 
 
 
-void vector_invert_self(std::vector<double> &vec)
+void vector_invert_self(vector_3d &vec)
 {
   for(std::size_t cur_coord = 0; cur_coord < axes_num; ++cur_coord)
   {
@@ -206,10 +224,10 @@ void vector_invert_self(std::vector<double> &vec)
 
 
 
-std::vector<double> vector_plus(const std::vector<double> &first,
-                                const std::vector<double> &second)
+vector_3d vector_plus(const vector_3d &first,
+                      const vector_3d &second)
 {
-  std::vector<double> ret(axes_num, 0.0);
+  vector_3d ret = vector_3d_filled(0.0);
   for(std::size_t cur_coord = 0; cur_coord < axes_num; ++cur_coord)
   {
     ret[cur_coord] = first[cur_coord] + second[cur_coord];
@@ -219,8 +237,8 @@ std::vector<double> vector_plus(const std::vector<double> &first,
 
 
 
-void vector_plus_self(std::vector<double> &first,
-                      const std::vector<double> &second)
+void vector_plus_self(vector_3d &first,
+                      const vector_3d &second)
 {
   for(std::size_t cur_coord = 0; cur_coord < axes_num; ++cur_coord)
   {
@@ -230,10 +248,10 @@ void vector_plus_self(std::vector<double> &first,
 
 
 
-std::vector<double> vector_minus(const std::vector<double> &first,
-                                 const std::vector<double> &second)
+vector_3d vector_minus(const vector_3d &first,
+                       const vector_3d &second)
 {
-  std::vector<double> ret(axes_num, 0.0);
+  vector_3d ret = vector_3d_filled(0.0);
   for(std::size_t cur_coord = 0; cur_coord < axes_num; ++cur_coord)
   {
     ret[cur_coord] = first[cur_coord] - second[cur_coord];
@@ -243,8 +261,8 @@ std::vector<double> vector_minus(const std::vector<double> &first,
 
 
 
-void vector_minus_self(std::vector<double> &first,
-                       const std::vector<double> &second)
+void vector_minus_self(vector_3d &first,
+                       const vector_3d &second)
 {
   for(std::size_t cur_coord = 0; cur_coord < axes_num; ++cur_coord)
   {
@@ -254,10 +272,10 @@ void vector_minus_self(std::vector<double> &first,
 
 
 
-std::vector<double> vector_multiply(const std::vector<double> &first,
-                                    const std::vector<double> &second)
+vector_3d vector_multiply(const vector_3d &first,
+                          const vector_3d &second)
 {
-  std::vector<double> ret(axes_num, 0.0);
+  vector_3d ret = vector_3d_filled(0.0);
   for(std::size_t cur_coord = 0; cur_coord < axes_num; ++cur_coord)
   {
     ret[cur_coord] = first[cur_coord] * second[cur_coord];
@@ -267,8 +285,8 @@ std::vector<double> vector_multiply(const std::vector<double> &first,
 
 
 
-void vector_multiply_self(std::vector<double> &first,
-                          const std::vector<double> &second)
+void vector_multiply_self(vector_3d &first,
+                          const vector_3d &second)
 {
   for(std::size_t cur_coord = 0; cur_coord < axes_num; ++cur_coord)
   {
@@ -278,10 +296,10 @@ void vector_multiply_self(std::vector<double> &first,
 
 
 
-std::vector<double> vector_multiply(const std::vector<double> &vec,
-                                    double num)
+vector_3d vector_multiply(const vector_3d &vec,
+                          double num)
 {
-  std::vector<double> ret(axes_num, 0.0);
+  vector_3d ret = vector_3d_filled(0.0);
   for(std::size_t cur_coord = 0; cur_coord < axes_num; ++cur_coord)
   {
     ret[cur_coord] = vec[cur_coord] * num;
@@ -291,7 +309,7 @@ std::vector<double> vector_multiply(const std::vector<double> &vec,
 
 
 
-void vector_multiply_self(std::vector<double> &vec,
+void vector_multiply_self(vector_3d &vec,
                           double num)
 {
   for(std::size_t cur_coord = 0; cur_coord < axes_num; ++cur_coord)
@@ -302,10 +320,10 @@ void vector_multiply_self(std::vector<double> &vec,
 
 
 
-std::vector<double> vector_divide(const std::vector<double> &first,
-                                  const std::vector<double> &second)
+vector_3d vector_divide(const vector_3d &first,
+                        const vector_3d &second)
 {
-  std::vector<double> ret(axes_num, 0.0);
+  vector_3d ret = vector_3d_filled(0.0);
   for(std::size_t cur_coord = 0; cur_coord < axes_num; ++cur_coord)
   {
     ret[cur_coord] = first[cur_coord] / second[cur_coord];
@@ -315,8 +333,8 @@ std::vector<double> vector_divide(const std::vector<double> &first,
 
 
 
-void vector_divide_self(std::vector<double> &first,
-                        const std::vector<double> &second)
+void vector_divide_self(vector_3d &first,
+                        const vector_3d &second)
 {
   for(std::size_t cur_coord = 0; cur_coord < axes_num; ++cur_coord)
   {
@@ -326,10 +344,10 @@ void vector_divide_self(std::vector<double> &first,
 
 
 
-std::vector<double> vector_divide(const std::vector<double> &vec,
-                                  double num)
+vector_3d vector_divide(const vector_3d &vec,
+                        double num)
 {
-  std::vector<double> ret(axes_num, 0.0);
+  vector_3d ret = vector_3d_filled(0.0);
   for(std::size_t cur_coord = 0; cur_coord < axes_num; ++cur_coord)
   {
     ret[cur_coord] = vec[cur_coord] / num;
@@ -339,7 +357,7 @@ std::vector<double> vector_divide(const std::vector<double> &vec,
 
 
 
-void vector_divide_self(std::vector<double> &vec,
+void vector_divide_self(vector_3d &vec,
                         double num)
 {
   for(std::size_t cur_coord = 0; cur_coord < axes_num; ++cur_coord)
@@ -350,7 +368,7 @@ void vector_divide_self(std::vector<double> &vec,
 
 
 
-double vector_length(const std::vector<double> &vec)
+double vector_length(const vector_3d &vec)
 {
   double length = 0.0;
   for(std::size_t cur_coord = 0; cur_coord < axes_num; ++cur_coord)
@@ -363,17 +381,17 @@ double vector_length(const std::vector<double> &vec)
 
 
 double vector_length_between(
-  const std::vector<double> &first,
-  const std::vector<double> &second)
+  const vector_3d &first,
+  const vector_3d &second)
 {
-  std::vector<double> tmp_vec = vector_minus(first, second);
+  vector_3d tmp_vec = vector_minus(first, second);
   return vector_length(tmp_vec);
 }
 
 
 
-double vector_dot_product(const std::vector<double> &first,
-                          const std::vector<double> &second)
+double vector_dot_product(const vector_3d &first,
+                          const vector_3d &second)
 {
   double dot_product = 0.0;
   for(std::size_t cur_coord = 0; cur_coord < axes_num; ++cur_coord)
@@ -385,8 +403,8 @@ double vector_dot_product(const std::vector<double> &first,
 
 
 
-double vector_angle(const std::vector<double> &first,
-                    const std::vector<double> &second)
+double vector_angle(const vector_3d &first,
+                    const vector_3d &second)
 {
   double length = vector_length(first) * vector_length(second);
   double dot_product = vector_dot_product(first, second);
@@ -407,10 +425,9 @@ double vector_angle(const std::vector<double> &first,
 
 
 
-std::vector<double> vector_2d_divide(const std::vector<double> &vec,
-                                     double num)
+vector_2d vector_2d_divide(const vector_2d &vec, double num)
 {
-  std::vector<double> ret(axes_2d_num, 0.0);
+  vector_2d ret = vector_2d_filled(0.0);
   for(std::size_t cur_coord = 0; cur_coord < axes_2d_num; ++cur_coord)
   {
     ret[cur_coord] = vec[cur_coord] / num;
@@ -420,7 +437,7 @@ std::vector<double> vector_2d_divide(const std::vector<double> &vec,
 
 
 
-double vector_2d_length(const std::vector<double> &vec)
+double vector_2d_length(const vector_2d &vec)
 {
   return std::hypot(vec[0], vec[1]);
 }
@@ -428,7 +445,7 @@ double vector_2d_length(const std::vector<double> &vec)
 
 
 unsigned long long int calc_norms::normal_to_key(
-  const std::vector<double> &norm)
+  const vector_3d &norm)
 {
   unsigned long long int key = 0;
   for(std::size_t cur_norm = 0; cur_norm < axes_num; ++cur_norm)
@@ -442,9 +459,9 @@ unsigned long long int calc_norms::normal_to_key(
   return key;
 }
 
-std::vector<double> calc_norms::key_to_normal(unsigned long long int key)
+vector_3d calc_norms::key_to_normal(unsigned long long int key)
 {
-  std::vector<double> norm(axes_num, 0.0);
+  vector_3d norm = vector_3d_filled(0.0);
   for(std::size_t cur_norm = 0; cur_norm < axes_num; ++cur_norm)
   {
     unsigned long long int natural_norm =
@@ -464,44 +481,44 @@ std::vector<double> calc_norms::key_to_normal(unsigned long long int key)
 
 model_extreme_points::model_extreme_points()
 : extreme_points_pair(
-    std::vector<double>(axes_num, -std::numeric_limits<double>::max()),
-    std::vector<double>(axes_num,  std::numeric_limits<double>::max())
+    vector_3d_filled(-std::numeric_limits<double>::max()),
+    vector_3d_filled( std::numeric_limits<double>::max())
   )
 {
 }
 
 model_extreme_points::model_extreme_points(
-  const std::vector<double> &max,
-  const std::vector<double> &min)
+  const vector_3d &max,
+  const vector_3d &min)
 : extreme_points_pair(max, min)
 {
 }
 
 model_extreme_points::model_extreme_points(
-  std::vector<double> &&max,
-  std::vector<double> &&min)
+  vector_3d &&max,
+  vector_3d &&min)
 : extreme_points_pair(max, min)
 {
 }
 
 
 
-std::vector<double> &model_extreme_points::max()
+vector_3d &model_extreme_points::max()
 {
   return extreme_points_pair.first;
 }
 
-const std::vector<double> &model_extreme_points::max() const
+const vector_3d &model_extreme_points::max() const
 {
   return extreme_points_pair.first;
 }
 
-std::vector<double> &model_extreme_points::min()
+vector_3d &model_extreme_points::min()
 {
   return extreme_points_pair.second;
 }
 
-const std::vector<double> &model_extreme_points::min() const
+const vector_3d &model_extreme_points::min() const
 {
   return extreme_points_pair.second;
 }
@@ -591,7 +608,7 @@ void model_extreme_points::get_most_extreme_cmp_cur(
 }
 
 void model_extreme_points::get_most_extreme_cmp_cur(
-  const std::vector<double> &point)
+  const vector_3d &point)
 {
   for(std::size_t cur_coord = 0; cur_coord < axes_num; ++cur_coord)
   {
@@ -607,14 +624,14 @@ void model_extreme_points::get_most_extreme_cmp_cur(
 }
 
 void model_extreme_points::get_most_extreme(
-  const std::vector<std::vector<double>> &points)
+  const std::vector<vector_3d> &points)
 {
   for(std::size_t cur_coord = 0; cur_coord < axes_num; ++cur_coord)
   {
     auto result =
       std::minmax_element(
         points.begin(), points.end(),
-        [&](std::vector<double> const& a, std::vector<double> const& b)
+        [&](vector_3d const& a, vector_3d const& b)
         {
           return a[cur_coord] < b[cur_coord];
         }
@@ -626,28 +643,28 @@ void model_extreme_points::get_most_extreme(
 
 
 
-std::vector<double> model_extreme_points::get_center()
+vector_3d model_extreme_points::get_center()
 {
   // Getting middle point of model as middle of extreme points.
-  std::vector<double> box_lengths = vector_minus(max(), min());
-  std::vector<double> box_half_lengths = vector_divide(box_lengths, 2);
-  std::vector<double> center_point = vector_plus(box_half_lengths, min());
+  vector_3d box_lengths = vector_minus(max(), min());
+  vector_3d box_half_lengths = vector_divide(box_lengths, 2);
+  vector_3d center_point = vector_plus(box_half_lengths, min());
   return center_point;
 }
 
 
 
 model_offset::model_offset()
-: offset_point(axes_num, 0.0)
+: offset_point(vector_3d_filled(0.0))
 {
 }
 
-model_offset::model_offset(const std::vector<double> &offset_point_arg)
+model_offset::model_offset(const vector_3d &offset_point_arg)
 : offset_point(offset_point_arg)
 {
 }
 
-model_offset::model_offset(std::vector<double> &&offset_point_arg)
+model_offset::model_offset(vector_3d &&offset_point_arg)
 : offset_point(offset_point_arg)
 {
 }
@@ -689,7 +706,7 @@ face::face(int numVerts_arg)
   color_id(0),
   wheel_id(invalid::wheel_id),
   weapon_id(invalid::weapon_id),
-  norm(std::vector<double>(axes_num, 0.0)),
+  norm(vector_3d_filled(0.0)),
   w(0.0),
   verts(std::vector<int>(numVerts, invalid::vert_id)),
   vertNorms(std::vector<int>(numVerts, invalid::vertNorm_id))
@@ -708,7 +725,7 @@ polyhedron::polyhedron()
   offset(),
   rmax(0.0),
   volume(0.0),
-  rcm(axes_num, 0.0),
+  rcm(vector_3d_filled(0.0)),
   J(axes_num, std::vector<double>(axes_num, 0.0)),
   bodyColorOffset(invalid::bodyColorOffset),
   bodyColorShift(invalid::bodyColorShift),
@@ -739,15 +756,12 @@ polyhedron::polyhedron(int numVerts_arg,
   offset(),
   rmax(0.0),
   volume(0.0),
-  rcm(axes_num, 0.0),
+  rcm(vector_3d_filled(0.0)),
   J(axes_num, std::vector<double>(axes_num, 0.0)),
   bodyColorOffset(invalid::bodyColorOffset),
   bodyColorShift(invalid::bodyColorShift),
-  verts(
-    std::vector<std::vector<double>>(numVerts, std::vector<double>(axes_num))),
-  vertNorms(
-    std::vector<std::vector<double>>(numVertNorms,
-                                     std::vector<double>(axes_num))),
+  verts(std::vector<vector_3d>(numVerts, vector_3d_filled(0.0))),
+  vertNorms(std::vector<vector_3d>(numVertNorms, vector_3d_filled(0.0))),
   faces(std::vector<face>(numFaces, face(verts_per_poly_arg))),
   ref_vert_one_ind(invalid::ref_vert_ind, invalid::ref_vert_ind),
   ref_vert_one(nullptr),
@@ -798,15 +812,15 @@ void polyhedron::reverse_polygons_orientation()
 
 
 
-std::vector<double> polyhedron::face_calc_normal(std::size_t face_ind)
+vector_3d polyhedron::face_calc_normal(std::size_t face_ind)
 {
   face &cur_face = faces[face_ind];
-  std::vector<double> normal(axes_num, 0.0);
+  vector_3d normal = vector_3d_filled(0.0);
   for(std::size_t cur_vert = 0; cur_vert < numVertsPerPoly; ++cur_vert)
   {
-    const std::vector<double> &current =
+    const vector_3d &current =
       verts[cur_face.verts[cur_vert]];
-    const std::vector<double> &next =
+    const vector_3d &next =
       verts[cur_face.verts[(cur_vert + 1) % numVertsPerPoly]];
     for(std::size_t cur_coord = 0; cur_coord < axes_num; ++cur_coord)
     {
@@ -896,22 +910,83 @@ double polyhedron::get_vertex_angle(std::size_t face_ind, std::size_t vert_ind)
   std::size_t prev_ind =
     (vert_ind + cur_face.numVerts - 1) % cur_face.numVerts;
   std::size_t next_ind = (vert_ind + 1) % cur_face.numVerts;
-  std::vector<double> &prev_vertex = verts[cur_face.verts[prev_ind]];
-  std::vector<double> &cur_vertex =  verts[cur_face.verts[vert_ind]];
-  std::vector<double> &next_vertex = verts[cur_face.verts[next_ind]];
+  vector_3d &prev_vertex = verts[cur_face.verts[prev_ind]];
+  vector_3d &cur_vertex =  verts[cur_face.verts[vert_ind]];
+  vector_3d &next_vertex = verts[cur_face.verts[next_ind]];
   return vector_angle(vector_minus(cur_vertex, prev_vertex),
                       vector_minus(cur_vertex, next_vertex));
 }
 
 
 
+calc_norms::vert_face_adjacency polyhedron::get_vert_face_adjacency() const
+{
+  calc_norms::vert_face_adjacency adjacency;
+  adjacency.offsets.assign(numVerts + 1, 0);
+
+  // Vertex may appear in the same face more than once only
+  // in degenerate face, in that case its last position in face is used.
+  auto is_last_in_face = [&](const face &cur_face, std::size_t vert_f_ind)
+  {
+    for(std::size_t next_f_ind = vert_f_ind + 1;
+        next_f_ind < numVertsPerPoly;
+        ++next_f_ind)
+    {
+      if(cur_face.verts[next_f_ind] == cur_face.verts[vert_f_ind])
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // Counting faces per vertex.
+  for(const auto &cur_face : faces)
+  {
+    for(std::size_t vert_f_ind = 0; vert_f_ind < numVertsPerPoly; ++vert_f_ind)
+    {
+      if(is_last_in_face(cur_face, vert_f_ind))
+      {
+        ++adjacency.offsets[cur_face.verts[vert_f_ind] + 1];
+      }
+    }
+  }
+  std::partial_sum(adjacency.offsets.begin(),
+                   adjacency.offsets.end(),
+                   adjacency.offsets.begin());
+
+  // Filling faces in order of their indices.
+  adjacency.face_inds.resize(adjacency.offsets.back());
+  adjacency.vert_f_inds.resize(adjacency.offsets.back());
+  std::vector<std::size_t> fill_pos(adjacency.offsets.begin(),
+                                    adjacency.offsets.end() - 1);
+  for(std::size_t face_ind = 0; face_ind < numFaces; ++face_ind)
+  {
+    const face &cur_face = faces[face_ind];
+    for(std::size_t vert_f_ind = 0; vert_f_ind < numVertsPerPoly; ++vert_f_ind)
+    {
+      if(is_last_in_face(cur_face, vert_f_ind))
+      {
+        std::size_t &cur_pos = fill_pos[cur_face.verts[vert_f_ind]];
+        adjacency.face_inds[cur_pos] = face_ind;
+        adjacency.vert_f_inds[cur_pos] = vert_f_ind;
+        ++cur_pos;
+      }
+    }
+  }
+
+  return adjacency;
+}
+
+
+
 // Must be called after faces_calc_params().
 void polyhedron::recalc_vertNorms(double max_smooth_angle)
 {
   // Creating norm per each vertex per face.
-  std::vector<std::vector<double>> raw_vertNorms(
+  std::vector<vector_3d> raw_vertNorms(
     numVertTotal,
-    std::vector<double>(axes_num, 0.0));
+    vector_3d_filled(0.0));
 
   // Assigning unique id to each norm per vertex per face.
   for(std::size_t face_ind = 0, norm_ind = 0; face_ind < numFaces; ++face_ind)
@@ -925,9 +1000,9 @@ void polyhedron::recalc_vertNorms(double max_smooth_angle)
   }
 
   // Calculating non-normalized face normals.
-  std::vector<std::vector<double>> raw_face_norms(
+  std::vector<vector_3d> raw_face_norms(
     numFaces,
-    std::vector<double>(axes_num, 0.0));
+    vector_3d_filled(0.0));
   for(std::size_t face_ind = 0; face_ind < numFaces; ++face_ind)
   {
     raw_face_norms[face_ind] = face_calc_normal(face_ind);
@@ -946,132 +1021,84 @@ void polyhedron::recalc_vertNorms(double max_smooth_angle)
     }
   }
 
-  // Getting map per each vertex: face index - vertex face index.
-  std::vector<std::unordered_map<std::size_t, std::size_t>>
-    vert_to_face_ind_vert_f_ind_pair(numVerts);
-  for(std::size_t vert_ind = 0; vert_ind < numVerts; ++vert_ind)
-  {
-    vert_to_face_ind_vert_f_ind_pair[vert_ind].reserve(
-      calc_norms::expected_connected_polygons_per_vertex);
-  }
+  calc_norms::vert_face_adjacency adjacency = get_vert_face_adjacency();
 
-  for(std::size_t face_ind = 0; face_ind < numFaces; ++face_ind)
-  {
-    face &cur_face = faces[face_ind];
-    for(std::size_t vert_f_ind = 0; vert_f_ind < numVertsPerPoly; ++vert_f_ind)
-    {
-      std::size_t vert_ind = cur_face.verts[vert_f_ind];
-      vert_to_face_ind_vert_f_ind_pair[vert_ind][face_ind] = vert_f_ind;
-    }
-  }
-
-  // Calculating angles between faces.
-  std::unordered_map<
-    std::pair<std::size_t, std::size_t>,
-    double,
-    boost::hash<std::pair<std::size_t, std::size_t>>> angles_between_faces;
-  angles_between_faces.reserve(
-    calc_norms::expected_connected_polygons_per_polygon * numFaces);
+  // https://www.bytehazard.com/articles/vertnorm.html
+  // Accumulating normals vertex by vertex.
+  // Angles between faces around current vertex are calculated once
+  // and stored in smooth_faces matrix which is reused for every vertex.
+  std::vector<char> smooth_faces;
+  smooth_faces.reserve(calc_norms::expected_connected_polygons_per_vertex *
+                       calc_norms::expected_connected_polygons_per_vertex);
   for(std::size_t vert_ind = 0; vert_ind < numVerts; ++vert_ind)
   {
-    for(auto face_ind_vert_f_ind_pair :
-        vert_to_face_ind_vert_f_ind_pair[vert_ind])
+    const std::size_t adj_beg = adjacency.offsets[vert_ind];
+    const std::size_t adj_size = adjacency.offsets[vert_ind + 1] - adj_beg;
+    const std::size_t *adj_face_inds = &adjacency.face_inds[adj_beg];
+    const std::size_t *adj_vert_f_inds = &adjacency.vert_f_inds[adj_beg];
+
+    // Using angles between faces to determine
+    // whether vertices between faces should be smooth.
+    smooth_faces.assign(adj_size * adj_size, 0);
+    for(std::size_t first = 0; first < adj_size; ++first)
     {
-      std::size_t face_ind = face_ind_vert_f_ind_pair.first;
-      for(auto face_ind_vert_f_ind_pair_to_cmp :
-          vert_to_face_ind_vert_f_ind_pair[vert_ind])
+      for(std::size_t second = first + 1; second < adj_size; ++second)
       {
-        std::size_t face_ind_to_cmp = face_ind_vert_f_ind_pair_to_cmp.first;
-        // Ignore self.
-        if(face_ind == face_ind_to_cmp)
+        std::size_t first_face_ind = adj_face_inds[first];
+        std::size_t second_face_ind = adj_face_inds[second];
+        if(first_face_ind > second_face_ind)
         {
-          continue;
-        }
-
-        std::pair<std::size_t, std::size_t> face_inds_pair =
-          {face_ind, face_ind_to_cmp};
-        if(face_inds_pair.first > face_inds_pair.second)
-        {
-          std::swap(face_inds_pair.first, face_inds_pair.second);
+          std::swap(first_face_ind, second_face_ind);
         }
-
-        // Skip if already in map.
-        if(angles_between_faces.count(face_inds_pair))
+        double angle =
+          vector_angle(faces[first_face_ind].norm,
+                       faces[second_face_ind].norm);
+        // Criteria for hard-edges.
+        if(angle - max_smooth_angle < distinct_distance)
         {
-          continue;
+          smooth_faces[first * adj_size + second] = 1;
+          smooth_faces[second * adj_size + first] = 1;
         }
-        double angle =
-          vector_angle(faces[face_inds_pair.first].norm,
-                       faces[face_inds_pair.second].norm);
-        angles_between_faces[face_inds_pair] = angle;
       }
     }
-  }
-
-  // Using angles between faces to determine
-  // whether vertices between faces should be smooth.
-  std::unordered_set<
-    std::pair<std::size_t, std::size_t>,
-    boost::hash<std::pair<std::size_t, std::size_t>>>
-      smooth_faces;
-  smooth_faces.reserve(angles_between_faces.size());
-  for(auto face_pair_to_angle : angles_between_faces)
-  {
-    if(face_pair_to_angle.second - max_smooth_angle < distinct_distance)
-    {
-      smooth_faces.insert(face_pair_to_angle.first);
-    }
-  }
 
-
-
-  // https://www.bytehazard.com/articles/vertnorm.html
-  // Accumulating normals in each face.
-  for(std::size_t face_ind = 0; face_ind < numFaces; ++face_ind)
-  {
-    face &cur_face = faces[face_ind];
-    for(std::size_t vert_f_ind = 0; vert_f_ind < numVertsPerPoly; ++vert_f_ind)
+    for(std::size_t cur_adj = 0; cur_adj < adj_size; ++cur_adj)
     {
-      std::size_t vert_ind = cur_face.verts[vert_f_ind];
-      std::size_t norm_ind = cur_face.vertNorms[vert_f_ind];
-      std::vector<double> &cur_norm = raw_vertNorms[norm_ind];
-      // No need to get weight per surface since non-normalized
-      // face norm length is directly proportional to surface area of face.
-      cur_norm = vector_multiply(raw_face_norms[face_ind],
-                                 vert_angles[face_ind][vert_f_ind]);
-
-      for(auto face_ind_vert_f_ind_pair_to_cmp :
-          vert_to_face_ind_vert_f_ind_pair[vert_ind])
+      std::size_t face_ind = adj_face_inds[cur_adj];
+      face &cur_face = faces[face_ind];
+      for(std::size_t vert_f_ind = 0;
+          vert_f_ind < numVertsPerPoly;
+          ++vert_f_ind)
       {
-        std::size_t face_ind_to_cmp = face_ind_vert_f_ind_pair_to_cmp.first;
-
-        // Ignore self.
-        if(face_ind == face_ind_to_cmp)
+        if(static_cast<std::size_t>(cur_face.verts[vert_f_ind]) != vert_ind)
         {
           continue;
         }
 
-        std::pair<std::size_t, std::size_t> face_inds_pair =
-          {face_ind, face_ind_to_cmp};
-        if(face_inds_pair.first > face_inds_pair.second)
-        {
-          std::swap(face_inds_pair.first, face_inds_pair.second);
-        }
+        std::size_t norm_ind = cur_face.vertNorms[vert_f_ind];
+        vector_3d &cur_norm = raw_vertNorms[norm_ind];
+        // No need to get weight per surface since non-normalized
+        // face norm length is directly proportional to surface area of face.
+        cur_norm = vector_multiply(raw_face_norms[face_ind],
+                                   vert_angles[face_ind][vert_f_ind]);
 
-        // Criteria for hard-edges.
-        if(!smooth_faces.count(face_inds_pair))
+        const char *cur_smooth_faces = &smooth_faces[cur_adj * adj_size];
+        for(std::size_t adj_to_cmp = 0; adj_to_cmp < adj_size; ++adj_to_cmp)
         {
-          continue;
-        }
+          // Ignoring self and hard edges.
+          if(!cur_smooth_faces[adj_to_cmp])
+          {
+            continue;
+          }
 
-        // Accumulate normal.
-        std::size_t vert_f_ind_to_cmp = face_ind_vert_f_ind_pair_to_cmp.second;
-        // No need to get weight per surface since non-normalized
-        // face norm length is directly proportional to surface area of face.
-        std::vector<double> norm_to_add =
-          vector_multiply(raw_face_norms[face_ind_to_cmp],
-                          vert_angles[face_ind_to_cmp][vert_f_ind_to_cmp]);
-        vector_plus_self(cur_norm, norm_to_add);
+          // Accumulate normal.
+          std::size_t face_ind_to_cmp = adj_face_inds[adj_to_cmp];
+          std::size_t vert_f_ind_to_cmp = adj_vert_f_inds[adj_to_cmp];
+          vector_3d norm_to_add =
+            vector_multiply(raw_face_norms[face_ind_to_cmp],
+                            vert_angles[face_ind_to_cmp][vert_f_ind_to_cmp]);
+          vector_plus_self(cur_norm, norm_to_add);
+        }
       }
     }
   }
@@ -1094,7 +1121,7 @@ void polyhedron::recalc_vertNorms(double max_smooth_angle)
     normal_val_to_norm_ind;
   normal_val_to_norm_ind.reserve(raw_vertNorms_size);
 
-  vertNorms = std::vector<std::vector<double>>();
+  vertNorms = std::vector<vector_3d>();
   vertNorms.reserve(raw_vertNorms_size);
   std::size_t norm_ind = 0;
 
@@ -1127,10 +1154,9 @@ void polyhedron::recalc_vertNorms(double max_smooth_angle)
 
 
 // Must be called after faces_calc_params().
-double polyhedron::check_volume()
+double polyhedron::check_volume() const
 {
-  compVolumeIntegrals(this);
-  return T0;
+  return compVolumeIntegrals(this).T0;
 }
 
 
@@ -1146,7 +1172,7 @@ void polyhedron::get_extreme_points()
 
 
 
-std::vector<double> polyhedron::get_model_center()
+vector_3d polyhedron::get_model_center()
 {
   get_extreme_points();
   return extreme_points.get_center();
@@ -1156,7 +1182,7 @@ std::vector<double> polyhedron::get_model_center()
 
 
 
-void polyhedron::move_model_to_point(const std::vector<double> &point_arg)
+void polyhedron::move_model_to_point(const vector_3d &point_arg)
 {
   for(auto &&model_vert : verts)
   {
@@ -1167,7 +1193,7 @@ void polyhedron::move_model_to_point(const std::vector<double> &point_arg)
 
 
 void polyhedron::move_model_to_point_inv_neg_vol(
-  const std::vector<double> &point_arg)
+  const vector_3d &point_arg)
 {
   move_model_to_point(point_arg);
   faces_calc_params_inv_neg_vol();
@@ -1176,7 +1202,7 @@ void polyhedron::move_model_to_point_inv_neg_vol(
 
 
 void polyhedron::move_coord_system_to_point(
-  const std::vector<double> &point_arg)
+  const vector_3d &point_arg)
 {
   for(auto &&model_vert : verts)
   {
@@ -1187,7 +1213,7 @@ void polyhedron::move_coord_system_to_point(
 
 
 void polyhedron::move_coord_system_to_point_inv_neg_vol(
-  const std::vector<double> &point_arg)
+  const vector_3d &point_arg)
 {
   move_coord_system_to_point(point_arg);
   faces_calc_params_inv_neg_vol();
@@ -1197,7 +1223,7 @@ void polyhedron::move_coord_system_to_point_inv_neg_vol(
 
 void polyhedron::move_coord_system_to_center()
 {
-  std::vector<double> center = get_model_center();
+  vector_3d center = get_model_center();
   move_coord_system_to_point(center);
 }
 
@@ -1285,10 +1311,10 @@ bool polyhedron::find_ref_points()
       {
         for(std::size_t v_2_ind = 0; v_2_ind < v_per_poly; ++v_2_ind)
         {
-          const std::vector<double> *cur_point =
+          const vector_3d *cur_point =
             &verts.at(faces[poly_2_ind].verts[v_2_ind]);
 
-          std::vector<double> rel_to_one =
+          vector_3d rel_to_one =
             vector_minus((*cur_point), (*ref_vert_one));
 
           if((std::abs(rel_to_one[0]) > distinct_distance ||
@@ -1306,7 +1332,7 @@ bool polyhedron::find_ref_points()
             {
               for(std::size_t v_3_ind = 0; v_3_ind < v_per_poly; ++v_3_ind)
               {
-                const std::vector<double> *cur_point =
+                const vector_3d *cur_point =
                   &verts.at(faces[poly_3_ind].verts[v_3_ind]);
 
                 double x1 = (*ref_vert_two)[0] - (*ref_vert_one)[0];
@@ -1376,7 +1402,11 @@ void polyhedron::calculate_c3d_properties()
 
   calculate_rmax();
 
-  compVolumeIntegrals(this);
+  const volume_integrals integrals = compVolumeIntegrals(this);
+  const double &T0 = integrals.T0;
+  const double *T1 = integrals.T1;
+  const double *T2 = integrals.T2;
+  const double *TP = integrals.TP;
 
   if(T0 < 0)
   {
@@ -1450,28 +1480,26 @@ void polyhedron::calculate_c3d_properties()
 // 3   2
 //       axis 0
 // 0   1
-std::vector<std::vector<std::vector<double>>>
+std::vector<std::vector<vector_2d>>
   polyhedron::get_planes_4_extreme_points() const
 {
-  std::vector<std::vector<std::vector<double>>> plane_4_extreme_points_by_axis(
+  std::vector<std::vector<vector_2d>> plane_4_extreme_points_by_axis(
     axes_num,
-    std::vector<std::vector<double>>(generate_bound::plane_extrs_num,
-                                     std::vector<double>(axes_2d_num, 0.0)));
+    std::vector<vector_2d>(generate_bound::plane_extrs_num,
+                           vector_2d_filled(0.0)));
   for(std::size_t cur_axis = 0; cur_axis < axes_num; ++cur_axis)
   {
     std::vector<std::size_t> plane_axes = axes_by_plane[cur_axis];
 
-    std::vector<double> plane_max_point(axes_2d_num, 0.0);
+    vector_2d plane_max_point = vector_2d_filled(0.0);
     plane_max_point[0] = max_point()[plane_axes[0]];
     plane_max_point[1] = max_point()[plane_axes[1]];
 
-    std::vector<double> plane_min_point(axes_2d_num, 0.0);
+    vector_2d plane_min_point = vector_2d_filled(0.0);
     plane_min_point[0] = min_point()[plane_axes[0]];
     plane_min_point[1] = min_point()[plane_axes[1]];
 
-    std::vector<std::vector<double>> plane_minmax_points(
-      2,
-      std::vector<double>(axes_2d_num, 0.0));
+    std::vector<vector_2d> plane_minmax_points(2, vector_2d_filled(0.0));
     plane_minmax_points[0][0] = max_point()[plane_axes[0]];
     plane_minmax_points[0][1] = min_point()[plane_axes[1]];
 
@@ -1491,8 +1519,8 @@ std::vector<std::vector<std::vector<double>>>
 std::vector<std::unordered_map<std::size_t, double>>
   polyhedron::get_verts_plane_lengths_rel_points(
     std::size_t perpendicular_axis,
-    const std::vector<std::vector<double>> &verts_arg,
-    const std::vector<std::vector<double>> &points_2d,
+    const std::vector<vector_3d> &verts_arg,
+    const std::vector<vector_2d> &points_2d,
     const generate_bound::layer_vert_inds &vert_inds)
 {
   std::size_t points_2d_size = points_2d.size();
@@ -1503,11 +1531,11 @@ std::vector<std::unordered_map<std::size_t, double>>
       point_2d_ind < points_2d_size;
       ++point_2d_ind)
   {
-    const std::vector<double> &cur_point_2d_value = points_2d[point_2d_ind];
+    const vector_2d &cur_point_2d_value = points_2d[point_2d_ind];
     std::for_each(std::begin(vert_inds), std::end(vert_inds),
       [&](std::size_t vert_ind)
       {
-        std::vector<double> vert_rel_to_point_2d(axes_2d_num, 0.0);
+        vector_2d vert_rel_to_point_2d = vector_2d_filled(0.0);
         for(std::size_t plane_2d_axis = 0;
             plane_2d_axis < axes_2d_num;
             ++plane_2d_axis)
@@ -1555,7 +1583,7 @@ generate_bound::layer_vert_inds polyhedron::get_min_length_layer_points(
 
 double polyhedron::get_plane_area_from_points(
     std::size_t perpendicular_axis,
-    const std::vector<std::vector<double>> &verts_arg,
+    const std::vector<vector_3d> &verts_arg,
     const generate_bound::layer_vert_inds &vert_inds)
 {
   double area = 0.0;
@@ -1566,8 +1594,8 @@ double polyhedron::get_plane_area_from_points(
   {
     std::size_t cur_vert_ind =  vert_inds[vert_ind_ind];
     std::size_t next_vert_ind = vert_inds[(vert_ind_ind + 1) % vert_inds_size];
-    const std::vector<double> &current = verts_arg[cur_vert_ind];
-    const std::vector<double> &next =    verts_arg[next_vert_ind];
+    const vector_3d &current = verts_arg[cur_vert_ind];
+    const vector_3d &next =    verts_arg[next_vert_ind];
     area += (current[model_3d_axes[0]] + next[model_3d_axes[0]]) *
             (current[model_3d_axes[1]] - next[model_3d_axes[1]]);
   }
@@ -1576,22 +1604,22 @@ double polyhedron::get_plane_area_from_points(
 
 
 
-std::vector<std::vector<double>> polyhedron::get_extr_middle_points(
+std::vector<vector_2d> polyhedron::get_extr_middle_points(
   std::size_t perpendicular_axis,
-  const std::vector<std::vector<double>> &verts_arg,
+  const std::vector<vector_3d> &verts_arg,
   const generate_bound::layer_vert_inds &layer_extrs)
 {
-  std::vector<std::vector<double>> extr_middle_points_2d(
+  std::vector<vector_2d> extr_middle_points_2d(
     generate_bound::plane_middle_extr_num,
-    std::vector<double>(axes_2d_num, 0.0));
+    vector_2d_filled(0.0));
   for(std::size_t cur_middle_point = 0;
       cur_middle_point < generate_bound::plane_middle_extr_num;
       ++cur_middle_point)
   {
-    std::vector<double> extr_points_2d_sum(axes_2d_num, 0.0);
+    vector_2d extr_points_2d_sum = vector_2d_filled(0.0);
     for(auto extr_ind : generate_bound::extr_lines[cur_middle_point])
     {
-      const std::vector<double> &extr_point = verts_arg[layer_extrs[extr_ind]];
+      const vector_3d &extr_point = verts_arg[layer_extrs[extr_ind]];
       for(std::size_t plane_2d_axis = 0;
           plane_2d_axis < axes_2d_num;
           ++plane_2d_axis)
@@ -1617,7 +1645,7 @@ std::vector<std::vector<double>> polyhedron::get_extr_middle_points(
 // m3 m4 m1 x
 // e0 m0 e1
 polyhedron polyhedron::extr_inds_to_bound(
-  const std::vector<std::vector<double>> &verts_arg,
+  const std::vector<vector_3d> &verts_arg,
   const generate_bound::layers_inds_of_axis &extr_inds,
   const generate_bound::layers_inds_of_axis &middle_inds,
   generate_bound::model_type type,
@@ -1625,7 +1653,7 @@ polyhedron polyhedron::extr_inds_to_bound(
 {
   polyhedron bound_model;
   bound_model.verts =
-    std::vector<std::vector<double>>(generate_bound::model::num_verts);
+    std::vector<vector_3d>(generate_bound::model::num_verts);
 
   std::size_t end_z_layers_num = extr_inds.size();
   std::size_t extr_size = generate_bound::model::extr_to_end.size();
@@ -1704,7 +1732,7 @@ polyhedron polyhedron::extr_inds_to_bound(
       const std::vector<std::size_t> &extremes =
         vert_to_center_by_extremes.second;
 
-      std::vector<double> extr_center(axes_num, 0.0);
+      vector_3d extr_center = vector_3d_filled(0.0);
       for(auto extr_ind : extremes)
       {
         vector_plus_self(extr_center, bound_model.verts[extr_ind]);
@@ -1779,11 +1807,11 @@ polyhedron polyhedron::generate_bound_model(
 
 
 
-  std::vector<double> model_dimensions(axes_num, 0.0);
+  vector_3d model_dimensions = vector_3d_filled(0.0);
   model_dimensions = vector_minus(max_point(), min_point());
 
   // Getting distance between layers for each axis.
-  std::vector<double> layer_step_per_axis(axes_num, 0.0);
+  vector_3d layer_step_per_axis = vector_3d_filled(0.0);
   for(std::size_t cur_axis = 0; cur_axis < axes_num; ++cur_axis)
   {
     layer_step_per_axis[cur_axis] =
@@ -1818,13 +1846,13 @@ polyhedron polyhedron::generate_bound_model(
 
 
   // Creating layer_verts from points of intersection between edges and layers.
-  std::vector<std::vector<double>> verts_rel_min = verts;
+  std::vector<vector_3d> verts_rel_min = verts;
   for(auto &&vert : verts_rel_min)
   {
     vector_minus_self(vert, min_point());
   }
 
-  std::vector<std::vector<double>> layers_verts;
+  std::vector<vector_3d> layers_verts;
   layers_verts.reserve(
     edges.size() * axes_num * generate_bound::expected_inter_verts_per_edge);
   generate_bound::layers_inds_by_axis layers_vert_inds(axes_num);
@@ -1835,8 +1863,8 @@ polyhedron polyhedron::generate_bound_model(
     const std::vector<std::size_t> &plane_axes = axes_by_plane[cur_axis];
     for(auto edge : edges)
     {
-      std::vector<double> first_v_rel_min =  verts_rel_min[edge.first];
-      std::vector<double> second_v_rel_min = verts_rel_min[edge.second];
+      vector_3d first_v_rel_min =  verts_rel_min[edge.first];
+      vector_3d second_v_rel_min = verts_rel_min[edge.second];
 
       // If both points are at the same plane
       // which is perpendicular to cur_axis.
@@ -1900,14 +1928,14 @@ polyhedron polyhedron::generate_bound_model(
         top_layer = std::floor(second_v_rel_min[cur_axis] / layer_step);
       }
 
-      std::vector<double> direction =
+      vector_3d direction =
         vector_minus(second_v_rel_min, first_v_rel_min);
 
       for(std::size_t layer_ind = low_layer, max_layer = top_layer + 1;
           layer_ind < max_layer;
           ++layer_ind)
       {
-        std::vector<double> layer_inter_vert(axes_num);
+        vector_3d layer_inter_vert = vector_3d_filled(0.0);
 
         layer_inter_vert[cur_axis] = layer_ind * layer_step;
 
@@ -1933,7 +1961,7 @@ polyhedron polyhedron::generate_bound_model(
   // Getting extreme points per plane.
   // Extreme points are generated in such order
   // they can be used as polygon vertices to find area.
-  std::vector<std::vector<std::vector<double>>>
+  std::vector<std::vector<vector_2d>>
     plane_4_extreme_points_by_axis =
       get_planes_4_extreme_points();
 
@@ -2191,7 +2219,7 @@ polyhedron polyhedron::generate_bound_model(
   // layers_extrs_inds will be used to form end bound model.
   // Finding medium points to form
   // standard Vangers bound model with 9 vertices per side.
-  std::vector<std::vector<std::vector<double>>> middle_points(end_layers_num);
+  std::vector<std::vector<vector_2d>> middle_points(end_layers_num);
   for(std::size_t end_layer = 0; end_layer < end_layers_num; ++end_layer)
   {
     middle_points[end_layer] =
@@ -2237,34 +2265,34 @@ polyhedron polyhedron::generate_bound_model(
 
 
 
-std::pair<std::vector<double>, std::vector<double>> &
+std::pair<vector_3d, vector_3d> &
   polyhedron::extreme_points_pair()
 {
   return extreme_points.extreme_points_pair;
 }
 
-const std::pair<std::vector<double>, std::vector<double>> &
+const std::pair<vector_3d, vector_3d> &
   polyhedron::extreme_points_pair() const
 {
   return extreme_points.extreme_points_pair;
 }
 
-std::vector<double> &polyhedron::max_point()
+vector_3d &polyhedron::max_point()
 {
   return extreme_points.max();
 }
 
-const std::vector<double> &polyhedron::max_point() const
+const vector_3d &polyhedron::max_point() const
 {
   return extreme_points.max();
 }
 
-std::vector<double> &polyhedron::min_point()
+vector_3d &polyhedron::min_point()
 {
   return extreme_points.min();
 }
 
-const std::vector<double> &polyhedron::min_point() const
+const vector_3d &polyhedron::min_point() const
 {
   return extreme_points.min();
 }
@@ -2335,12 +2363,12 @@ void polyhedron::set_zmin(double new_zmin)
 
 
 
-std::vector<double> &polyhedron::offset_point()
+vector_3d &polyhedron::offset_point()
 {
   return offset.offset_point;
 }
 
-const std::vector<double> &polyhedron::offset_point() const
+const vector_3d &polyhedron::offset_point() const
 {
   return offset.offset_point;
 }
@@ -2385,7 +2413,8 @@ void polyhedron::set_z_off(double new_z_off)
 
 
 // Compute various integrations over projection of face.
-void compProjectionIntegrals(POLYHEDRON *p, FACE *f)
+void volume_integrator::compProjectionIntegrals(const POLYHEDRON *p,
+                                                const FACE *f)
 {
   double a0, a1, da;
   double b0, b1, db;
@@ -2448,16 +2477,15 @@ void compProjectionIntegrals(POLYHEDRON *p, FACE *f)
   Pabb /= -60.0;
 }
 
-void compFaceIntegrals(POLYHEDRON *p, FACE *f)
+void volume_integrator::compFaceIntegrals(const POLYHEDRON *p, const FACE *f)
 {
-  std::vector<double> n;
   double w;
   double k1, k2, k3, k4;
 
   compProjectionIntegrals(p, f);
 
   w = f->w;
-  n = f->norm;
+  const vector_3d &n = f->norm;
   k1 = 1 / n[C]; k2 = k1 * k1; k3 = k2 * k1; k4 = k3 * k1;
 
   Fa =    k1 * Pa;
@@ -2490,12 +2518,18 @@ void compFaceIntegrals(POLYHEDRON *p, FACE *f)
                 w * (2 * (n[A] * Paa + n[B] * Pab) + w * Pa));
 }
 
-void compVolumeIntegrals(POLYHEDRON *p)
+volume_integrals volume_integrator::compVolumeIntegrals(const POLYHEDRON *p)
 {
-  FACE *f;
+  const FACE *f;
   double nx, ny, nz;
   int i;
 
+  volume_integrals res;
+  double &T0 = res.T0;
+  double *T1 = res.T1;
+  double *T2 = res.T2;
+  double *TP = res.TP;
+
   T0 = T1[VOLINT_X] = T1[VOLINT_Y] = T1[VOLINT_Z] 
      = T2[VOLINT_X] = T2[VOLINT_Y] = T2[VOLINT_Z] 
      = TP[VOLINT_X] = TP[VOLINT_Y] = TP[VOLINT_Z] = 0;
@@ -2531,6 +2565,14 @@ void compVolumeIntegrals(POLYHEDRON *p)
   T1[VOLINT_X] /= 2; T1[VOLINT_Y] /= 2; T1[VOLINT_Z] /= 2;
   T2[VOLINT_X] /= 3; T2[VOLINT_Y] /= 3; T2[VOLINT_Z] /= 3;
   TP[VOLINT_X] /= 2; TP[VOLINT_Y] /= 2; TP[VOLINT_Z] /= 2;
+
+  return res;
+}
+
+volume_integrals compVolumeIntegrals(const POLYHEDRON *p)
+{
+  volume_integrator integrator;
+  return integrator.compVolumeIntegrals(p);
 }
 
 
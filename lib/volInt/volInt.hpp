@@ -54,6 +54,7 @@
 #include <cmath>
 #include <utility>
 #include <limits>
+#include <array>
 #include <vector>
 #include <deque>
 #include <map>
@@ -103,71 +104,80 @@ enum class rotation_axis : std::size_t {x = 0, y = 1, z = 2};
 
 
 
+// Points and directions are stored by value
+// so arrays of them are contiguous and math on them doesn't allocate.
+typedef std::array<double, 3> vector_3d;
+typedef std::array<double, 2> vector_2d;
+
+vector_3d vector_3d_filled(double value);
+vector_2d vector_2d_filled(double value);
+
+
+
 double degrees_to_radians(double degrees);
 
 double sicher_angle_to_radians(int sicher_angle);
 int radians_to_sicher_angle(double radians);
 
-void rotate_point_by_axis(std::vector<double> &point,
+void rotate_point_by_axis(vector_3d &point,
                           double angle_sin,
                           double angle_cos,
                           rotation_axis axis);
-void rotate_point_by_axis(std::vector<double> &point,
+void rotate_point_by_axis(vector_3d &point,
                           double angle,
                           rotation_axis axis);
 
 
 
-std::vector<double> vector_scale(double norm, const std::vector<double> &vec);
-void vector_scale_self(double norm, std::vector<double> &vec);
+vector_3d vector_scale(double norm, const vector_3d &vec);
+void vector_scale_self(double norm, vector_3d &vec);
 
-void vector_invert_self(std::vector<double> &vec);
+void vector_invert_self(vector_3d &vec);
 
-std::vector<double> vector_plus(const std::vector<double> &first,
-                                const std::vector<double> &second);
-void vector_plus_self(std::vector<double> &first,
-                      const std::vector<double> &second);
-std::vector<double> vector_minus(const std::vector<double> &first,
-                                 const std::vector<double> &second);
-void vector_minus_self(std::vector<double> &first,
-                       const std::vector<double> &second);
+vector_3d vector_plus(const vector_3d &first,
+                      const vector_3d &second);
+void vector_plus_self(vector_3d &first,
+                      const vector_3d &second);
+vector_3d vector_minus(const vector_3d &first,
+                       const vector_3d &second);
+void vector_minus_self(vector_3d &first,
+                       const vector_3d &second);
 
-std::vector<double> vector_multiply(const std::vector<double> &first,
-                                    const std::vector<double> &second);
-void vector_multiply_self(std::vector<double> &first,
-                          const std::vector<double> &second);
-std::vector<double> vector_multiply(const std::vector<double> &vec,
-                                    double num);
-void vector_multiply_self(std::vector<double> &vec,
+vector_3d vector_multiply(const vector_3d &first,
+                          const vector_3d &second);
+void vector_multiply_self(vector_3d &first,
+                          const vector_3d &second);
+vector_3d vector_multiply(const vector_3d &vec,
+                          double num);
+void vector_multiply_self(vector_3d &vec,
                           double num);
 
-std::vector<double> vector_divide(const std::vector<double> &first,
-                                  const std::vector<double> &second);
-void vector_divide_self(std::vector<double> &first,
-                        const std::vector<double> &second);
-std::vector<double> vector_divide(const std::vector<double> &vec,
-                                  double num);
-void vector_divide_self(std::vector<double> &vec,
+vector_3d vector_divide(const vector_3d &first,
+                        const vector_3d &second);
+void vector_divide_self(vector_3d &first,
+                        const vector_3d &second);
+vector_3d vector_divide(const vector_3d &vec,
+                        double num);
+void vector_divide_self(vector_3d &vec,
                         double num);
 
-double vector_length(const std::vector<double> &vec);
+double vector_length(const vector_3d &vec);
 
 double vector_length_between(
-  const std::vector<double> &first,
-  const std::vector<double> &second);
+  const vector_3d &first,
+  const vector_3d &second);
 
 double vector_dot_product(
-  const std::vector<double> &first,
-  const std::vector<double> &second);
+  const vector_3d &first,
+  const vector_3d &second);
 
 double vector_angle(
-  const std::vector<double> &first,
-  const std::vector<double> &second);
+  const vector_3d &first,
+  const vector_3d &second);
 
-std::vector<double> vector_2d_divide(const std::vector<double> &vec,
-                                     double num);
+vector_2d vector_2d_divide(const vector_2d &vec, double num);
 
-double vector_2d_length(const std::vector<double> &vec);
+double vector_2d_length(const vector_2d &vec);
 
 
 
@@ -232,8 +242,19 @@ std::vector<std::vector<T>> get_groups_of_connected_items(
 
 
 namespace calc_norms{
-  unsigned long long int normal_to_key(const std::vector<double> &norm);
-  std::vector<double> key_to_normal(unsigned long long int key);
+  unsigned long long int normal_to_key(const vector_3d &norm);
+  vector_3d key_to_normal(unsigned long long int key);
+
+  // Faces around each vertex in compressed sparse row form.
+  // Faces of vertex vert_ind are stored in
+  // [offsets[vert_ind], offsets[vert_ind + 1]) range of face_inds,
+  // vert_f_inds holds position of vertex in each of those faces.
+  struct vert_face_adjacency
+  {
+    std::vector<std::size_t> offsets;
+    std::vector<std::size_t> face_inds;
+    std::vector<std::size_t> vert_f_inds;
+  };
 } // namespace calc_norms
 
 
@@ -308,7 +329,6 @@ namespace color_ids {
 
 namespace calc_norms{
   const std::size_t expected_connected_polygons_per_vertex = 10;
-  const std::size_t expected_connected_polygons_per_polygon = 10;
 
   const double to_integer_multiply = std::pow(10, min_float_precision);
   const unsigned long long int upper_bound =
@@ -490,14 +510,14 @@ struct model_extreme_points
 {
 
   model_extreme_points();
-  model_extreme_points(const std::vector<double> &max,
-                       const std::vector<double> &min);
-  model_extreme_points(std::vector<double> &&max, std::vector<double> &&min);
+  model_extreme_points(const vector_3d &max,
+                       const vector_3d &min);
+  model_extreme_points(vector_3d &&max, vector_3d &&min);
 
-  std::vector<double>       &max();
-  const std::vector<double> &max() const;
-  std::vector<double>       &min();
-  const std::vector<double> &min() const;
+  vector_3d       &max();
+  const vector_3d &max() const;
+  vector_3d       &min();
+  const vector_3d &min() const;
 
   double xmax() const;
   double ymax() const;
@@ -516,12 +536,12 @@ struct model_extreme_points
   void set_zmin(double new_zmin);
 
   void get_most_extreme_cmp_cur(const model_extreme_points &other);
-  void get_most_extreme_cmp_cur(const std::vector<double>  &point);
-  void get_most_extreme(const std::vector<std::vector<double>> &points);
+  void get_most_extreme_cmp_cur(const vector_3d  &point);
+  void get_most_extreme(const std::vector<vector_3d> &points);
 
-  std::vector<double> get_center();
+  vector_3d get_center();
 
-  std::pair<std::vector<double>, std::vector<double>> extreme_points_pair;
+  std::pair<vector_3d, vector_3d> extreme_points_pair;
 
 };
 
@@ -529,8 +549,8 @@ struct model_offset
 {
 
   model_offset();
-  model_offset(const std::vector<double> &offset_point_arg);
-  model_offset(std::vector<double>      &&offset_point_arg);
+  model_offset(const vector_3d &offset_point_arg);
+  model_offset(vector_3d      &&offset_point_arg);
 
   double x_off() const;
   double y_off() const;
@@ -540,7 +560,7 @@ struct model_offset
   void set_y_off(double new_y_off);
   void set_z_off(double new_z_off);
 
-  std::vector<double> offset_point;
+  vector_3d offset_point;
 
 };
 
@@ -552,7 +572,7 @@ typedef struct face
   unsigned int color_id;
   int wheel_id;
   int weapon_id;
-  std::vector<double> norm;
+  vector_3d norm;
   double w;
   std::vector<int> verts;
   std::vector<int> vertNorms;
@@ -571,28 +591,29 @@ typedef struct polyhedron
   void invertVertNorms();
   void reverse_polygons_orientation();
 
-  std::vector<double> face_calc_normal(std::size_t face_ind);
+  vector_3d face_calc_normal(std::size_t face_ind);
   double face_calc_offset_w(           std::size_t face_ind);
   void faces_calc_params(); // Must be called again if model was moved.
   void faces_calc_params_inv_neg_vol();
 
   double get_vertex_angle(std::size_t face_ind, std::size_t vert_ind);
 
+  calc_norms::vert_face_adjacency get_vert_face_adjacency() const;
   void recalc_vertNorms(double max_smooth_angle);
 
-  double check_volume();
+  double check_volume() const;
 
   void get_extreme_points();
 
 
-  std::vector<double> get_model_center();
+  vector_3d get_model_center();
 
-  void move_model_to_point(const std::vector<double> &point);
-  void move_model_to_point_inv_neg_vol(const std::vector<double> &point);
+  void move_model_to_point(const vector_3d &point);
+  void move_model_to_point_inv_neg_vol(const vector_3d &point);
 
-  void move_coord_system_to_point(const std::vector<double> &point);
+  void move_coord_system_to_point(const vector_3d &point);
   void move_coord_system_to_point_inv_neg_vol(
-    const std::vector<double> &point);
+    const vector_3d &point);
   void move_coord_system_to_center();
 
   void rotate_by_axis(double angle, rotation_axis axis);
@@ -609,27 +630,26 @@ typedef struct polyhedron
   void calculate_c3d_properties();
 
 
-  std::vector<std::vector<std::vector<double>>>
-    get_planes_4_extreme_points() const;
+  std::vector<std::vector<vector_2d>> get_planes_4_extreme_points() const;
   static std::vector<std::unordered_map<std::size_t, double>>
     get_verts_plane_lengths_rel_points(
       std::size_t perpendicular_axis,
-      const std::vector<std::vector<double>> &verts_arg,
-      const std::vector<std::vector<double>> &points_2d,
+      const std::vector<vector_3d> &verts_arg,
+      const std::vector<vector_2d> &points_2d,
       const generate_bound::layer_vert_inds &vert_inds);
   static generate_bound::layer_vert_inds get_min_length_layer_points(
     const std::vector<std::unordered_map<std::size_t, double>> &
       verts_plane_lengths_rel_points);
   static double get_plane_area_from_points(
     std::size_t perpendicular_axis,
-    const std::vector<std::vector<double>> &verts_arg,
+    const std::vector<vector_3d> &verts_arg,
     const generate_bound::layer_vert_inds &vert_inds);
-  static std::vector<std::vector<double>> get_extr_middle_points(
+  static std::vector<vector_2d> get_extr_middle_points(
     std::size_t perpendicular_axis,
-    const std::vector<std::vector<double>> &verts_arg,
+    const std::vector<vector_3d> &verts_arg,
     const generate_bound::layer_vert_inds &layer_extrs);
   polyhedron extr_inds_to_bound(
-    const std::vector<std::vector<double>> &verts_arg,
+    const std::vector<vector_3d> &verts_arg,
     const generate_bound::layers_inds_of_axis &extr_inds,
     const generate_bound::layers_inds_of_axis &middle_inds,
     generate_bound::model_type type,
@@ -640,13 +660,13 @@ typedef struct polyhedron
     const double area_threshold_multiplier,
     const model_extreme_points *wheel_params_extremes = nullptr) const;
 
-  std::pair<std::vector<double>, std::vector<double>> &extreme_points_pair();
-  const std::pair<std::vector<double>, std::vector<double>> &
+  std::pair<vector_3d, vector_3d> &extreme_points_pair();
+  const std::pair<vector_3d, vector_3d> &
     extreme_points_pair() const;
-  std::vector<double>       &max_point();
-  const std::vector<double> &max_point() const;
-  std::vector<double>       &min_point();
-  const std::vector<double> &min_point() const;
+  vector_3d       &max_point();
+  const vector_3d &max_point() const;
+  vector_3d       &min_point();
+  const vector_3d &min_point() const;
 
   double xmax() const;
   double ymax() const;
@@ -665,8 +685,8 @@ typedef struct polyhedron
   void set_zmin(double new_zmin);
 
 
-  std::vector<double>       &offset_point();
-  const std::vector<double> &offset_point() const;
+  vector_3d       &offset_point();
+  const vector_3d &offset_point() const;
 
   double x_off() const;
   double y_off() const;
@@ -682,24 +702,24 @@ typedef struct polyhedron
   model_offset offset;
   double rmax;
   double volume;
-  std::vector<double> rcm;
+  vector_3d rcm;
   std::vector<std::vector<double>> J;
   int bodyColorOffset, bodyColorShift;
-  std::vector<std::vector<double>> verts;
-  std::vector<std::vector<double>> vertNorms;
+  std::vector<vector_3d> verts;
+  std::vector<vector_3d> vertNorms;
   std::vector<face> faces;
 
 
 
   std::pair<int, int>        ref_vert_one_ind;
-  const std::vector<double> *ref_vert_one;
+  const vector_3d *ref_vert_one;
   std::pair<int, int>        ref_vert_two_ind;
-  const std::vector<double> *ref_vert_two;
+  const vector_3d *ref_vert_two;
   std::pair<int, int>        ref_vert_three_ind;
-  const std::vector<double> *ref_vert_three;
+  const vector_3d *ref_vert_three;
 
-  std::vector<double> ref_vert_two_rel_to_one;
-  std::vector<double> ref_vert_three_rel_to_one;
+  vector_3d ref_vert_two_rel_to_one;
+  vector_3d ref_vert_three_rel_to_one;
 
   double ref_angle;
 
@@ -725,36 +745,54 @@ typedef struct polyhedron
 
 
 // ============================================================================
-// Globals.
+// Compute mass properties.
 // ============================================================================
 
-static int A; // alpha
-static int B; // beta
-static int C; // gamma
 
-// Projection integrals.
-static double P1, Pa, Pb, Paa, Pab, Pbb, Paaa, Paab, Pabb, Pbbb;
-
-// Face integrals.
-static double Fa, Fb, Fc, Faa, Fbb, Fcc, Faaa, Fbbb, Fccc, Faab, Fbbc, Fcca;
 
 // Volume integrals.
-static double T0, T1[3], T2[3], TP[3];
+struct volume_integrals
+{
+  double T0;
+  double T1[3];
+  double T2[3];
+  double TP[3];
+};
 
 
 
-// ============================================================================
-// Compute mass properties.
-// ============================================================================
+// Holds intermediate state of single volume integration.
+// Each call uses its own integrator so any number of models
+// can be processed at the same time.
+class volume_integrator
+{
+
+public:
+
+  volume_integrals compVolumeIntegrals(const POLYHEDRON *p);
 
+private:
 
+  int A; // alpha
+  int B; // beta
+  int C; // gamma
+
+  // Projection integrals.
+  double P1, Pa, Pb, Paa, Pab, Pbb, Paaa, Paab, Pabb, Pbbb;
+
+  // Face integrals.
+  double Fa, Fb, Fc, Faa, Fbb, Fcc, Faaa, Fbbb, Fccc, Faab, Fbbc, Fcca;
+
+  // Compute various integrations over projection of face.
+  void compProjectionIntegrals(const POLYHEDRON *p, const FACE *f);
+
+  void compFaceIntegrals(const POLYHEDRON *p, const FACE *f);
+
+};
 
-// Compute various integrations over projection of face.
-void compProjectionIntegrals(POLYHEDRON *p, FACE *f);
 
-void compFaceIntegrals(FACE *f);
 
-void compVolumeIntegrals(POLYHEDRON *p);
+volume_integrals compVolumeIntegrals(const POLYHEDRON *p);
 
 
 
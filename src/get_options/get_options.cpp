@@ -165,6 +165,13 @@ boost::program_options::variables_map get_options(int ac, char** av)
                  "there must be " + ext::readable::pal +
                  " file with same name in \"" + option::name::pal_dir + "\"."
              "\n"
+             "\nSpecify \"" + option::name::tga_rle_compression + "\" "
+                 "option to save RLE compressed " + ext::readable::tga +
+                 " files."
+             "\nSpecify \"" + option::name::tga_bottom_left_origin + "\" "
+                 "option to save " + ext::readable::tga + " files "
+                 "with bottom left origin."
+             "\n"
              "\n\"" + option::name::source_dir + "\" and "
                  "\"" + option::name::output_dir + "\" "
                  "options must be specified."
@@ -174,7 +181,8 @@ boost::program_options::variables_map get_options(int ac, char** av)
            "\n\ttga_to_bmp - Convert " +
                ext::readable::tga + " images to Vangers " +
                ext::readable::bmp + " ones."
-             "\nRLE compression is not supported."
+             "\nRLE compressed " + ext::readable::tga +
+                 " images are supported."
              "\n"
              "\nSpecify \"" + option::name::items_bmp + "\" "
                  "option to convert item files."
@@ -260,6 +268,11 @@ boost::program_options::variables_map get_options(int ac, char** av)
              "\nSpecify \"" + option::name::use_custom_J_by_default + "\" "
                  "to enable by default custom inertia tensor "
                  "option in generated per-file configs."
+             "\nSpecify \"" + option::name::obj_binary_cache + "\" "
+                 "option to save binary caches of extracted " +
+                 ext::readable::obj + " files."
+             "\nUse \"" + option::name::jobs + "\" "
+                 "option to extract several models at the same time."
              "\n"
              "\n\"" + option::name::source_dir + "\" and "
                  "\"" + option::name::output_dir + "\" "
@@ -307,6 +320,17 @@ boost::program_options::variables_map get_options(int ac, char** av)
                  "option is used while generating bound models."
              "\n\"" + option::name::gen_bound_area_threshold + "\" "
                  "option is used while generating bound models."
+             "\nSpecify \"" + option::name::gen_polygon_sort_tables + "\" "
+                 "option to write sorted polygon tables used by the game "
+                 "for depth sorting."
+             "\nSpecify \"" + option::name::pack_sicher_cfg + "\" "
+                 "option to compress and encrypt " + ext::readable::prm +
+                 " and " + ext::readable::lst + " files."
+             "\nSpecify \"" + option::name::obj_binary_cache + "\" "
+                 "option to read " + ext::readable::obj + " files "
+                 "from binary caches when they are up to date."
+             "\nUse \"" + option::name::jobs + "\" "
+                 "option to convert several models at the same time."
              "\n"
              "\n\"" + option::name::source_dir + "\" and "
                  "\"" + option::name::output_dir + "\" "
@@ -423,6 +447,18 @@ boost::program_options::variables_map get_options(int ac, char** av)
        ("\tDirectory with color palettes for each input file.\n"
         "\tUsed by \"" + mode::name::bmp_to_tga + "\" and "
             "\"" + mode::name::tga_replace_pal + "\" modes.\n").c_str())
+      (option::name::tga_rle_compression.c_str(),
+       boost::program_options::bool_switch()->
+         default_value(option::default_val::tga_rle_compression),
+       ("\tSave RLE compressed " + ext::readable::tga + " files.\n"
+        "\tUsed by \"" + mode::name::bmp_to_tga + "\" mode.\n").c_str())
+      (option::name::tga_bottom_left_origin.c_str(),
+       boost::program_options::bool_switch()->
+         default_value(option::default_val::tga_bottom_left_origin),
+       ("\tSave " + ext::readable::tga + " files with rows stored "
+            "from bottom to top.\n"
+        "\tBy default rows are stored from top to bottom.\n"
+        "\tUsed by \"" + mode::name::bmp_to_tga + "\" mode.\n").c_str())
       (option::name::dir_to_compare.c_str(),
        boost::program_options::value<std::string>(),
        ("\tDirectory with " + ext::readable::bmp +
@@ -629,6 +665,37 @@ boost::program_options::variables_map get_options(int ac, char** av)
             option::max::gen_bound_area_threshold_str + ".\n"
         "\tUsed by \"" + mode::name::obj_to_vangers_3d_model + "\" "
             "mode.\n").c_str())
+      (option::name::gen_polygon_sort_tables.c_str(),
+       boost::program_options::bool_switch()->
+         default_value(option::default_val::gen_polygon_sort_tables),
+       ("\tWrite polygon indices sorted by middle points of polygons "
+            "along each axis\n"
+        "\tinto the tables reserved for them in " +
+            ext::readable::m3d_and_a3d + " files.\n"
+        "\tBy default these tables are filled with zeros.\n"
+        "\tUsed by \"" + mode::name::obj_to_vangers_3d_model + "\" "
+            "mode.\n").c_str())
+      (option::name::obj_binary_cache.c_str(),
+       boost::program_options::bool_switch()->
+         default_value(option::default_val::obj_binary_cache),
+       ("\tSave parsed " + ext::readable::obj + " files as binary caches "
+            "next to them (\"<name>" + ext::obj + ext::volInt_cache +
+            "\") and read them\n"
+        "\tinstead of parsing " + ext::readable::obj + " files again.\n"
+        "\tCache is used only while size and modification time of " +
+            ext::readable::obj + " file are unchanged.\n"
+        "\tUsed by \"" + mode::name::vangers_3d_model_to_obj + "\" and "
+            "\"" + mode::name::obj_to_vangers_3d_model + "\" "
+            "modes.\n").c_str())
+      (option::name::pack_sicher_cfg.c_str(),
+       boost::program_options::bool_switch()->
+         default_value(option::default_val::pack_sicher_cfg),
+       ("\tCompress and encrypt created " + ext::readable::prm + " and " +
+            ext::readable::lst + " files the same way "
+            "as files shipped with the game.\n"
+        "\tBy default they are saved as plain text.\n"
+        "\tUsed by \"" + mode::name::obj_to_vangers_3d_model + "\" "
+            "mode.\n").c_str())
       (option::name::mtl_n_wheels.c_str(),
        boost::program_options::value<std::size_t>()->
          default_value(option::default_val::mtl_n_wheels),
@@ -653,6 +720,21 @@ boost::program_options::variables_map get_options(int ac, char** av)
         "\tmtl_body_offs = 129_3;130_3\n"
         "\tUsed by \"" + mode::name::create_wavefront_mtl + "\" and "
             "\"" + mode::name::create_materials_table + "\" modes.\n").c_str())
+      (option::name::jobs.c_str(),
+       boost::program_options::value<std::size_t>()->
+         default_value(option::default_val::jobs),
+       ("\tNumber of threads used to convert files.\n"
+        "\t0 means number of hardware threads.\n"
+        "\tUsed by \"" + mode::name::vangers_3d_model_to_obj + "\", "
+            "\"" + mode::name::obj_to_vangers_3d_model + "\", "
+            "\"" + mode::name::bmp_to_tga + "\", "
+            "\"" + mode::name::tga_to_bmp + "\", "
+            "\"" + mode::name::tga_replace_pal + "\", "
+            "\"" + mode::name::tga_merge_unused_pal + "\", "
+            "\"" + mode::name::remove_not_used_pal + "\", "
+            "\"" + mode::name::extract_tga_pal + "\", "
+            "\"" + mode::name::usage_pal + "\" and "
+            "\"" + mode::name::cmp_bmp_escave_outside + "\" modes.\n").c_str())
       ;
 
     boost::program_options::options_description cmdline_options;
@@ -0,0 +1,76 @@
+#include "byte_histogram.hpp"
+
+
+
+namespace tractor_converter{
+namespace helpers{
+
+
+
+void byte_histogram_add(const char *data,
+                        std::size_t size,
+                        byte_histogram &histogram)
+{
+  const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+  std::uint32_t sub_tables[byte_histogram_sub_tables_num][byte_histogram_size];
+
+  for(std::size_t block_begin = 0;
+      block_begin < size;
+      block_begin += byte_histogram_block_size)
+  {
+    std::size_t block_end =
+      std::min(block_begin + byte_histogram_block_size, size);
+    std::memset(sub_tables, 0, sizeof(sub_tables));
+
+    std::size_t cur_byte = block_begin;
+    for(std::size_t end_byte = block_end - (block_end - block_begin) % 8;
+        cur_byte != end_byte;
+        cur_byte += 8)
+    {
+      std::uint64_t eight_bytes;
+      std::memcpy(&eight_bytes, bytes + cur_byte, sizeof(eight_bytes));
+      ++sub_tables[0][eight_bytes & 0xFF];
+      ++sub_tables[1][(eight_bytes >> 8) & 0xFF];
+      ++sub_tables[2][(eight_bytes >> 16) & 0xFF];
+      ++sub_tables[3][(eight_bytes >> 24) & 0xFF];
+      ++sub_tables[0][(eight_bytes >> 32) & 0xFF];
+      ++sub_tables[1][(eight_bytes >> 40) & 0xFF];
+      ++sub_tables[2][(eight_bytes >> 48) & 0xFF];
+      ++sub_tables[3][eight_bytes >> 56];
+    }
+    for(; cur_byte != block_end; ++cur_byte)
+    {
+      ++sub_tables[0][bytes[cur_byte]];
+    }
+
+    for(std::size_t cur_value = 0;
+        cur_value != byte_histogram_size;
+        ++cur_value)
+    {
+      for(std::size_t cur_table = 0;
+          cur_table != byte_histogram_sub_tables_num;
+          ++cur_table)
+      {
+        histogram[cur_value] += sub_tables[cur_table][cur_value];
+      }
+    }
+  }
+}
+
+
+
+void byte_histogram_merge(byte_histogram &histogram,
+                          const byte_histogram &histogram_to_add)
+{
+  for(std::size_t cur_value = 0;
+      cur_value != byte_histogram_size;
+      ++cur_value)
+  {
+    histogram[cur_value] += histogram_to_add[cur_value];
+  }
+}
+
+
+
+} // namespace helpers
+} // namespace tractor_converter
@@ -0,0 +1,48 @@
+#ifndef TRACTOR_CONVERTER_BYTE_HISTOGRAM_H
+#define TRACTOR_CONVERTER_BYTE_HISTOGRAM_H
+
+#include "defines.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <array>
+
+
+
+namespace tractor_converter{
+namespace helpers{
+
+
+
+const std::size_t byte_histogram_size = 256;
+
+// Number of occurrences of each byte value.
+typedef std::array<std::size_t, byte_histogram_size> byte_histogram;
+
+// Bytes are counted into several tables one after another
+// so increments of the same value in a row don't wait for each other.
+const std::size_t byte_histogram_sub_tables_num = 4;
+// Max number of bytes counted before sub-tables are added to histogram
+// so 32-bit counters of sub-tables can't overflow.
+const std::size_t byte_histogram_block_size = 1 << 30;
+
+
+
+// Adds number of occurrences of each byte value
+// in [data, data + size) to histogram.
+void byte_histogram_add(const char *data,
+                        std::size_t size,
+                        byte_histogram &histogram);
+
+// Adds counts of histogram_to_add to histogram.
+void byte_histogram_merge(byte_histogram &histogram,
+                          const byte_histogram &histogram_to_add);
+
+
+
+} // namespace helpers
+} // namespace tractor_converter
+
+#endif // TRACTOR_CONVERTER_BYTE_HISTOGRAM_H
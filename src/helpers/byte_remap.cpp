@@ -0,0 +1,82 @@
+#include "byte_remap.hpp"
+
+
+
+namespace tractor_converter{
+namespace helpers{
+
+
+
+byte_remap_table byte_remap_identity()
+{
+  byte_remap_table table;
+  for(std::size_t cur_byte = 0; cur_byte < byte_remap_table_size; ++cur_byte)
+  {
+    table[cur_byte] = static_cast<unsigned char>(cur_byte);
+  }
+  return table;
+}
+
+
+
+byte_remap_table byte_remap_from_shift_starts(
+  const std::array<std::size_t, byte_remap_table_size> &shift_starts)
+{
+  byte_remap_table table;
+  std::size_t shift = 0;
+  for(std::size_t cur_byte = 0; cur_byte < byte_remap_table_size; ++cur_byte)
+  {
+    shift += shift_starts[cur_byte];
+    table[cur_byte] = static_cast<unsigned char>(cur_byte + shift);
+  }
+  return table;
+}
+
+
+
+byte_remap_table byte_remap_from_bytes(const std::string &bytes)
+{
+  byte_remap_table table;
+  std::memcpy(table.data(), bytes.data(), byte_remap_table_size);
+  return table;
+}
+
+
+
+void byte_remap(const char *src,
+                char *dst,
+                std::size_t size,
+                const byte_remap_table &table)
+{
+  const unsigned char *src_bytes =
+    reinterpret_cast<const unsigned char *>(src);
+  unsigned char *dst_bytes = reinterpret_cast<unsigned char *>(dst);
+
+  // 8 independent lookups per iteration so loads from table
+  // are not serialized by the loop counter.
+  std::size_t cur_byte = 0;
+  for(std::size_t end_byte = size - size % 8;
+      cur_byte != end_byte;
+      cur_byte += 8)
+  {
+    unsigned char remapped[8];
+    remapped[0] = table[src_bytes[cur_byte]];
+    remapped[1] = table[src_bytes[cur_byte + 1]];
+    remapped[2] = table[src_bytes[cur_byte + 2]];
+    remapped[3] = table[src_bytes[cur_byte + 3]];
+    remapped[4] = table[src_bytes[cur_byte + 4]];
+    remapped[5] = table[src_bytes[cur_byte + 5]];
+    remapped[6] = table[src_bytes[cur_byte + 6]];
+    remapped[7] = table[src_bytes[cur_byte + 7]];
+    std::memcpy(dst_bytes + cur_byte, remapped, 8);
+  }
+  for(; cur_byte != size; ++cur_byte)
+  {
+    dst_bytes[cur_byte] = table[src_bytes[cur_byte]];
+  }
+}
+
+
+
+} // namespace helpers
+} // namespace tractor_converter
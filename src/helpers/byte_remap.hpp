@@ -0,0 +1,52 @@
+#ifndef TRACTOR_CONVERTER_BYTE_REMAP_H
+#define TRACTOR_CONVERTER_BYTE_REMAP_H
+
+#include "defines.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <string>
+
+
+
+namespace tractor_converter{
+namespace helpers{
+
+
+
+const std::size_t byte_remap_table_size = 256;
+
+// New value for each possible byte value.
+typedef std::array<unsigned char, byte_remap_table_size> byte_remap_table;
+
+
+
+// Table which maps every byte to itself.
+byte_remap_table byte_remap_identity();
+
+// Table which maps every byte value to value + sum of shift_starts
+// from 0 up to and including value, wrapped around 256.
+// It's used when colors are inserted into palette:
+// to insert n colors before color i, add n to shift_starts[i].
+byte_remap_table byte_remap_from_shift_starts(
+  const std::array<std::size_t, byte_remap_table_size> &shift_starts);
+
+// Table created from first byte_remap_table_size bytes of bytes.
+byte_remap_table byte_remap_from_bytes(const std::string &bytes);
+
+// Replaces size bytes of src with their values from table
+// and writes them to dst.
+// src and dst may be the same pointer.
+void byte_remap(const char *src,
+                char *dst,
+                std::size_t size,
+                const byte_remap_table &table);
+
+
+
+} // namespace helpers
+} // namespace tractor_converter
+
+#endif // TRACTOR_CONVERTER_BYTE_REMAP_H
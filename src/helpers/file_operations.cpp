@@ -17,15 +17,16 @@ std::string read_file(boost::filesystem::ifstream &file,
   std::string bytes_to_return;
   std::streamoff bytes_to_read_num;
 
-  file.seekg(start_byte_file_num, std::ios::end);
-  std::streamoff expected_file_size = file.tellg();
+  file.seekg(0, std::ios::end);
+  std::streamoff file_size = file.tellg();
   file.seekg(0, std::ios::beg);
 
   if(flags & file_flag::binary)
   {
     if(flags & file_flag::read_all)
     {
-      bytes_to_read_num = expected_file_size;
+      bytes_to_read_num =
+        std::max(file_size - start_byte_file_num, std::streamoff(0));
     }
     else
     {
@@ -42,13 +43,11 @@ std::string read_file(boost::filesystem::ifstream &file,
   }
   else
   {
-    bytes_to_return.reserve(expected_file_size * 2);
-    char buffer[read_buffer_size];
-    while(file.read(buffer, sizeof(buffer)))
-    {
-      bytes_to_return.append(buffer, sizeof(buffer));
-    }
-    bytes_to_return.append(buffer, file.gcount());
+    // Text is read from the start of the file.
+    // There may be less characters than bytes in the file but never more.
+    bytes_to_return.resize(file_size);
+    file.read(&bytes_to_return[0], file_size);
+    bytes_to_return.resize(file.gcount());
   }
 
   return bytes_to_return;
@@ -220,6 +219,269 @@ void save_file(const std::string &path_string,
             file_name_error);
 }
 
+void save_file(const boost::filesystem::path &path,
+               const std::vector<file_piece> &pieces_to_write,
+               const bitflag<file_flag> flags,
+               const std::string &file_name_error)
+{
+  std::ios_base::openmode mode = std::ios_base::out;
+  if(flags & file_flag::binary)
+  {
+    mode |= std::ios_base::binary;
+  }
+  boost::filesystem::ofstream file(path, mode);
+  if(!file)
+  {
+    throw exception::file_not_saved(
+      "Can't save " + file_name_error + " file \"" + path.string() + "\".");
+  }
+
+  for(const auto &piece : pieces_to_write)
+  {
+    file.write(piece.data, piece.size);
+  }
+  file.close();
+  if(!file)
+  {
+    throw exception::file_not_saved(
+      "Can't save " + file_name_error + " file \"" + path.string() + "\".");
+  }
+}
+
+
+
+
+
+file_view::file_view(const boost::filesystem::path &path,
+                     const std::string &file_name_error)
+: m_data(nullptr),
+  m_size(0)
+{
+  boost::system::error_code ec;
+  if(boost::filesystem::is_regular_file(path, ec))
+  {
+    std::uintmax_t file_size = boost::filesystem::file_size(path, ec);
+    if(!ec && file_size >= file_view_min_mapped_size)
+    {
+      try
+      {
+        mapped_file.open(path);
+      }
+      catch(std::exception &)
+      {
+        // Falling back to buffered read.
+      }
+      if(mapped_file.is_open())
+      {
+        m_data = mapped_file.data();
+        m_size = mapped_file.size();
+        return;
+      }
+    }
+  }
+
+  boost::filesystem::ifstream file(path,
+                                   std::ios_base::in | std::ios_base::binary);
+  if(!file)
+  {
+    throw exception::file_not_found(
+      "Can't open " + file_name_error + " file \"" + path.string() + "\".");
+  }
+  char read_buffer[read_buffer_size];
+  while(file.read(read_buffer, sizeof(read_buffer)))
+  {
+    buffer.append(read_buffer, sizeof(read_buffer));
+  }
+  buffer.append(read_buffer, file.gcount());
+
+  m_data = buffer.data();
+  m_size = buffer.size();
+}
+
+
+
+const char *file_view::data() const
+{
+  return m_data;
+}
+
+std::size_t file_view::size() const
+{
+  return m_size;
+}
+
+bool file_view::empty() const
+{
+  return !m_size;
+}
+
+
+
+const char *file_view::begin() const
+{
+  return m_data;
+}
+
+const char *file_view::end() const
+{
+  return m_data + m_size;
+}
+
+
+
+std::string file_view::substr(std::size_t pos, std::size_t count) const
+{
+  if(pos > m_size)
+  {
+    throw std::out_of_range(
+      "file_view::substr: pos " + std::to_string(pos) +
+      " is out of range of file with size " + std::to_string(m_size) + ".");
+  }
+  if(count > m_size - pos)
+  {
+    count = m_size - pos;
+  }
+  return std::string(m_data + pos, count);
+}
+
+
+
+bool file_view::mapped() const
+{
+  return mapped_file.is_open();
+}
+
+
+
+
+
+file_output_view::file_output_view(const boost::filesystem::path &path,
+                                   std::size_t size,
+                                   const std::string &file_name_error)
+: m_path(path),
+  m_file_name_error(file_name_error),
+  m_data(nullptr),
+  m_size(size),
+  committed(false)
+{
+  boost::filesystem::path temp_path_model = path;
+  temp_path_model += ".%%%%-%%%%-%%%%.tmp";
+  m_temp_path = boost::filesystem::unique_path(temp_path_model);
+
+  if(size >= file_view_min_mapped_size)
+  {
+    boost::iostreams::mapped_file_params params(m_temp_path.string());
+    params.new_file_size =
+      static_cast<boost::iostreams::stream_offset>(size);
+    try
+    {
+      // File is created beforehand so it gets the same permissions
+      // as files saved by save_file() instead of owner-only ones.
+      boost::filesystem::ofstream(m_temp_path,
+                                  std::ios_base::out | std::ios_base::binary);
+      mapped_file.open(params);
+    }
+    catch(std::exception &)
+    {
+      // Falling back to buffer saved by commit().
+    }
+    if(mapped_file.is_open())
+    {
+      m_data = mapped_file.data();
+      return;
+    }
+  }
+
+  buffer = std::string(size, '\0');
+  m_data = &buffer[0];
+}
+
+file_output_view::~file_output_view()
+{
+  if(committed)
+  {
+    return;
+  }
+  if(mapped_file.is_open())
+  {
+    try
+    {
+      mapped_file.close();
+    }
+    catch(std::exception &)
+    {
+    }
+  }
+  boost::system::error_code ec;
+  boost::filesystem::remove(m_temp_path, ec);
+}
+
+
+
+char *file_output_view::data()
+{
+  return m_data;
+}
+
+std::size_t file_output_view::size() const
+{
+  return m_size;
+}
+
+
+
+void file_output_view::commit()
+{
+  if(mapped_file.is_open())
+  {
+    try
+    {
+      mapped_file.close();
+    }
+    catch(std::exception &)
+    {
+      throw exception::file_not_saved(
+        "Can't save " + m_file_name_error + " file \"" +
+        m_path.string() + "\".");
+    }
+  }
+  else
+  {
+    save_file(m_temp_path, buffer, file_flag::binary, m_file_name_error);
+  }
+  m_data = nullptr;
+
+  boost::system::error_code ec;
+  std::uintmax_t written_size = boost::filesystem::file_size(m_temp_path, ec);
+  if(ec)
+  {
+    written_size = 0;
+  }
+  if(written_size != m_size)
+  {
+    throw exception::file_not_saved(
+      "Can't save " + m_file_name_error + " file \"" +
+      m_path.string() + "\". Expected to write " + std::to_string(m_size) +
+      " bytes but " + std::to_string(written_size) +
+      " bytes were written.");
+  }
+  boost::filesystem::rename(m_temp_path, m_path, ec);
+  if(ec)
+  {
+    throw exception::file_not_saved(
+      "Can't save " + m_file_name_error + " file \"" +
+      m_path.string() + "\".");
+  }
+  committed = true;
+}
+
+
+
+bool file_output_view::mapped() const
+{
+  return mapped_file.is_open();
+}
+
 
 
 
@@ -274,5 +536,49 @@ boost::filesystem::path filepath_case_insensitive_part_get(
 
 
 
+case_insensitive_path_index::case_insensitive_path_index()
+{
+}
+
+case_insensitive_path_index::case_insensitive_path_index(
+  const boost::filesystem::path &root_arg)
+: m_root(root_arg)
+{
+  for(const auto &entry :
+      boost::filesystem::recursive_directory_iterator(m_root))
+  {
+    std::string rel_path_lowercase_str =
+      boost::algorithm::to_lower_copy(
+        entry.path().lexically_relative(m_root).string());
+    // Keeping first found path if several differ only by case
+    // just like filepath_case_insensitive_part_get() does.
+    lowercase_to_real.emplace(std::move(rel_path_lowercase_str),
+                              entry.path());
+  }
+}
+
+
+
+boost::filesystem::path case_insensitive_path_index::get(
+  const boost::filesystem::path &case_insensitive_part) const
+{
+  auto found = lowercase_to_real.find(
+    boost::algorithm::to_lower_copy(case_insensitive_part.string()));
+  if(found == lowercase_to_real.end())
+  {
+    return boost::filesystem::path();
+  }
+  return found->second;
+}
+
+
+
+const boost::filesystem::path &case_insensitive_path_index::root() const
+{
+  return m_root;
+}
+
+
+
 } // namespace helpers
 } // namespace tractor_converter
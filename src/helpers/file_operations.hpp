@@ -6,12 +6,18 @@
 
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/algorithm/string.hpp>
 
 #include <exception>
 #include <stdexcept>
 
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
 #include <string>
+#include <vector>
+#include <unordered_map>
 
 
 
@@ -53,10 +59,22 @@ enum class file_flag
 
 
 
+// Part of data to save which is not owned by the piece.
+struct file_piece
+{
+  const char *data;
+  std::size_t size;
+};
+
+
+
 const std::size_t read_buffer_size = 4096;
+// Smaller files are read into buffer since mapping them is not worth it.
+const std::size_t file_view_min_mapped_size = 65536;
 
 
 
+// In binary mode first start_byte_file_num bytes of file are skipped.
 std::string read_file(boost::filesystem::ifstream &file,
                       const bitflag<file_flag> flags,
                       const int start_byte_string_num,
@@ -109,6 +127,100 @@ void save_file(const std::string &path_string,
                const std::string &bytes_to_write,
                const bitflag<file_flag> flags,
                const std::string &file_name_error);
+// Writes pieces one after another through single stream
+// so they don't have to be concatenated first.
+void save_file(const boost::filesystem::path &path,
+               const std::vector<file_piece> &pieces_to_write,
+               const bitflag<file_flag> flags,
+               const std::string &file_name_error);
+
+
+
+// Read-only view of the whole file to parse it in place.
+// Regular files which are at least file_view_min_mapped_size bytes
+// are memory-mapped and unmapped on destruction.
+// Smaller files, pipes and files which failed to map are read into buffer.
+class file_view
+{
+
+public:
+
+  file_view(const boost::filesystem::path &path,
+            const std::string &file_name_error);
+
+  file_view(const file_view &) = delete;
+  file_view &operator=(const file_view &) = delete;
+
+  const char *data() const;
+  std::size_t size() const;
+  bool empty() const;
+
+  const char *begin() const;
+  const char *end() const;
+
+  // Copies part of the file.
+  std::string substr(std::size_t pos, std::size_t count) const;
+
+  bool mapped() const;
+
+private:
+
+  boost::iostreams::mapped_file_source mapped_file;
+  std::string buffer;
+
+  const char *m_data;
+  std::size_t m_size;
+
+};
+
+
+
+// Writable view of new file of known size to write it in place.
+// Data is written to temporary file next to path
+// which replaces file at path only on commit(),
+// so existing file is left intact if saving fails.
+// Files which are at least file_view_min_mapped_size bytes
+// are created with that size and memory-mapped.
+// Smaller files and files which failed to map are written into buffer
+// which is saved by commit().
+// Initial contents are zero bytes in both cases.
+class file_output_view
+{
+
+public:
+
+  file_output_view(const boost::filesystem::path &path,
+                   std::size_t size,
+                   const std::string &file_name_error);
+  ~file_output_view();
+
+  file_output_view(const file_output_view &) = delete;
+  file_output_view &operator=(const file_output_view &) = delete;
+
+  char *data();
+  std::size_t size() const;
+
+  // Must be called when all data is written.
+  // If it's not called, temporary file is removed on destruction.
+  void commit();
+
+  bool mapped() const;
+
+private:
+
+  boost::iostreams::mapped_file_sink mapped_file;
+  std::string buffer;
+
+  boost::filesystem::path m_path;
+  boost::filesystem::path m_temp_path;
+  std::string m_file_name_error;
+
+  char *m_data;
+  std::size_t m_size;
+
+  bool committed;
+
+};
 
 
 
@@ -123,6 +235,33 @@ boost::filesystem::path filepath_case_insensitive_part_get(
 
 
 
+// Walks directory tree only once and then maps lowercase paths
+// relative to the root to the real ones.
+// Use it instead of filepath_case_insensitive_part_get()
+// when many files are looked up in the same directory.
+class case_insensitive_path_index
+{
+
+public:
+
+  case_insensitive_path_index();
+  case_insensitive_path_index(const boost::filesystem::path &root_arg);
+
+  // Returns empty path if nothing was found.
+  boost::filesystem::path get(
+    const boost::filesystem::path &case_insensitive_part) const;
+
+  const boost::filesystem::path &root() const;
+
+private:
+
+  boost::filesystem::path m_root;
+  std::unordered_map<std::string, boost::filesystem::path> lowercase_to_real;
+
+};
+
+
+
 } // namespace helpers
 } // namespace tractor_converter
 
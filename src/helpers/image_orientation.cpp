@@ -0,0 +1,64 @@
+#include "image_orientation.hpp"
+
+
+
+namespace tractor_converter{
+namespace helpers{
+
+
+
+void flip_image_horizontally(char *pixels,
+                             std::size_t width,
+                             std::size_t height)
+{
+  for(std::size_t current_y = 0; current_y != height; ++current_y)
+  {
+    char *row = pixels + current_y * width;
+    std::reverse(row, row + width);
+  }
+}
+
+
+
+void flip_image_vertically(char *pixels,
+                           std::size_t width,
+                           std::size_t height)
+{
+  // Swapping whole rows so memory is accessed sequentially.
+  std::vector<char> temp_row(width);
+  for(std::size_t top_y = 0, bottom_y = height - 1;
+      top_y < height / 2;
+      ++top_y,
+        --bottom_y)
+  {
+    char *top_row = pixels + top_y * width;
+    char *bottom_row = pixels + bottom_y * width;
+    std::memcpy(temp_row.data(), top_row, width);
+    std::memcpy(top_row, bottom_row, width);
+    std::memcpy(bottom_row, temp_row.data(), width);
+  }
+}
+
+
+
+void orient_image(char *pixels,
+                  std::size_t width,
+                  std::size_t height,
+                  unsigned char from_descriptor,
+                  unsigned char to_descriptor)
+{
+  unsigned char changed_bits = from_descriptor ^ to_descriptor;
+  if(changed_bits & tga_image_descriptor_right_to_left)
+  {
+    flip_image_horizontally(pixels, width, height);
+  }
+  if(changed_bits & tga_image_descriptor_top_to_bottom)
+  {
+    flip_image_vertically(pixels, width, height);
+  }
+}
+
+
+
+} // namespace helpers
+} // namespace tractor_converter
@@ -0,0 +1,45 @@
+#ifndef TRACTOR_CONVERTER_IMAGE_ORIENTATION_H
+#define TRACTOR_CONVERTER_IMAGE_ORIENTATION_H
+
+#include "defines.hpp"
+#include "tga_constants.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+
+
+
+namespace tractor_converter{
+namespace helpers{
+
+
+
+// Functions for 8 bits per pixel images stored row by row.
+
+// Reverses each row.
+void flip_image_horizontally(char *pixels,
+                             std::size_t width,
+                             std::size_t height);
+
+// Reverses order of rows.
+void flip_image_vertically(char *pixels,
+                           std::size_t width,
+                           std::size_t height);
+
+// Flips image stored with origin of *.tga image descriptor from_descriptor
+// so it's stored with origin of to_descriptor.
+// Only origin bits of descriptors are compared.
+void orient_image(char *pixels,
+                  std::size_t width,
+                  std::size_t height,
+                  unsigned char from_descriptor,
+                  unsigned char to_descriptor);
+
+
+
+} // namespace helpers
+} // namespace tractor_converter
+
+#endif // TRACTOR_CONVERTER_IMAGE_ORIENTATION_H
@@ -29,6 +29,7 @@ m3d_to_wavefront_obj_model::m3d_to_wavefront_obj_model(
     weapon_attachment_point_arg,
     ghost_wheel_model_arg,
     center_of_mass_model_arg),
+  m3d_file(input_m3d_path_arg, input_file_name_error_arg),
   float_precision_objs(float_precision_objs_arg),
   flags(flags_arg)
 {
@@ -36,13 +37,6 @@ m3d_to_wavefront_obj_model::m3d_to_wavefront_obj_model(
 
   scale_size = scale_size_arg;
 
-  m3d_data =
-    read_file(input_m3d_path,
-              file_flag::binary | file_flag::read_all,
-              0,
-              0,
-              read_all_dummy_size,
-              input_file_name_error);
   m3d_data_cur_pos = 0;
 
   float_precision_objs_string =
@@ -375,114 +369,117 @@ boost::filesystem::path
 
 
 
-std::vector<double> m3d_to_wavefront_obj_model::read_vertex()
+void m3d_to_wavefront_obj_model::check_m3d_data_left(std::size_t size) const
 {
-  std::vector<double> vert =
-    read_vec_var_from_m3d_scaled<float, double>(volInt::axes_num);
-  std::vector<double> discarded_less_preciese_vert =
-    read_vec_var_from_m3d_scaled<char, double>(volInt::axes_num);
-  int discarded_sort_info = read_var_from_m3d<std::int32_t, int>();
-  return vert;
+  if(m3d_data_cur_pos > m3d_file.size() ||
+     m3d_file.size() - m3d_data_cur_pos < size)
+  {
+    throw std::runtime_error(
+      input_file_name_error + " file " +
+      input_m3d_path.string() + " is too short. " +
+      "Expected " + std::to_string(size) + " bytes at position " +
+      std::to_string(m3d_data_cur_pos) + ", but file size is " +
+      std::to_string(m3d_file.size()) + ".");
+  }
 }
 
-void m3d_to_wavefront_obj_model::read_vertices(volInt::polyhedron &model)
+void m3d_to_wavefront_obj_model::skip_m3d_data(std::size_t size)
 {
-  for(std::size_t cur_vertex = 0; cur_vertex < model.numVerts; ++cur_vertex)
-  {
-    model.verts[cur_vertex] = read_vertex();
-  }
+  check_m3d_data_left(size);
+  m3d_data_cur_pos += size;
 }
 
 
 
-std::vector<double> m3d_to_wavefront_obj_model::read_normal(
-  bitflag<normal_flag> flags = normal_flag::sort_info)
+void m3d_to_wavefront_obj_model::read_vertices(volInt::polyhedron &model)
 {
-  std::vector<double> norm =
-    volInt::vector_scale(
-      wavefront_obj::vector_scale_val,
-      read_vec_var_from_m3d<char, double>(volInt::axes_num));
-  unsigned char discarded_n_power =
-    read_var_from_m3d<unsigned char, unsigned char>();
-  if(flags & normal_flag::sort_info)
+  // Only full precision coordinates are needed.
+  // Compact coordinates and sort info are skipped.
+  for(auto &&vert : model.verts)
   {
-    int discarded_sort_info = read_var_from_m3d<std::int32_t, int>();
+    vert = read_record_point_from_m3d<float>(
+      c3d::vertex::full_coord_x_rel_pos, scale_size);
+    m3d_data_cur_pos += c3d::vertex::size;
   }
-  return norm;
 }
 
+
+
 void m3d_to_wavefront_obj_model::read_normals(volInt::polyhedron &model)
 {
-  for(std::size_t norm_ind = 0; norm_ind < model.numVertNorms; ++norm_ind)
+  // n_power and sort info are skipped.
+  for(auto &&norm : model.vertNorms)
   {
-    model.vertNorms[norm_ind] = read_normal();
+    norm =
+      volInt::vector_scale(
+        wavefront_obj::vector_scale_val,
+        read_record_point_from_m3d<char>(c3d::normal::coord_x_rel_pos));
+    m3d_data_cur_pos += c3d::normal::size;
   }
 }
 
 
-volInt::face m3d_to_wavefront_obj_model::read_polygon(
-  const volInt::polyhedron &model, std::size_t cur_poly)
+void m3d_to_wavefront_obj_model::read_polygon(volInt::face &poly,
+                                              std::size_t cur_poly)
 {
-  int numVerts = read_var_from_m3d<std::int32_t, int>();
-  if(model.numVertsPerPoly != numVerts)
+  int numVerts = read_record_var_from_m3d<std::int32_t>(
+    c3d::polygon::vertex_num_rel_pos);
+  if(poly.numVerts != numVerts)
   {
     throw std::runtime_error(
       "In " + input_file_name_error +
       " file " + input_m3d_path.string() +
       " polygon " + std::to_string(cur_poly) +
       " at position " +
-      std::to_string(m3d_data_cur_pos - sizeof(int)) +
+      std::to_string(m3d_data_cur_pos + c3d::polygon::vertex_num_rel_pos) +
       " has unexpected number of vertices " +
       std::to_string(numVerts) +
-      ". Expected " + std::to_string(model.numVertsPerPoly) + ".");
+      ". Expected " + std::to_string(poly.numVerts) + ".");
   }
-  volInt::face poly(numVerts);
 
-  int discarded_sort_info = read_var_from_m3d<std::int32_t, int>();
-
-  poly.color_id = read_var_from_m3d<std::uint32_t, unsigned int>();
+  poly.color_id = read_record_var_from_m3d<std::uint32_t>(
+    c3d::polygon::color_id_rel_pos);
   if(poly.color_id >= c3d::color::string_to_id::max_colors_ids)
   {
     poly.color_id = c3d::color::string_to_id::body;
   }
 
-  unsigned int color_shift = read_var_from_m3d<std::uint32_t, unsigned int>();
+  unsigned int color_shift = read_record_var_from_m3d<std::uint32_t>(
+    c3d::polygon::color_shift_rel_pos);
   if(color_shift)
   {
-    std::cout << "\n\n" <<
+    thread_log() << "\n\n" <<
       input_file_name_error << " file " <<
       input_m3d_path.string() <<
       ". polygon " << std::to_string(cur_poly) <<
       " at position " +
-      std::to_string(m3d_data_cur_pos - sizeof(unsigned int)) +
+      std::to_string(m3d_data_cur_pos + c3d::polygon::color_shift_rel_pos) +
       " has non-zero color_shift " << std::to_string(color_shift) <<
       ". It is assumed that color_shift of any polygon is always 0." << '\n';
   }
 
-
-  std::vector<double> discarded_flat_normal =
-    read_normal(normal_flag::none);
-  std::vector<double> discarded_medium_vert =
-    read_vec_var_from_m3d_scaled<char, double>(volInt::axes_num);
-
+  // Sort info, flat normal and middle point are skipped.
   // Note the reverse order of vertices.
+  std::size_t vert_rel_pos = c3d::polygon::vert_norm_ind_arr_rel_pos;
   for(std::size_t vert_f_ind = 0, vert_f_ind_r = numVerts - 1;
       vert_f_ind < numVerts;
       ++vert_f_ind, --vert_f_ind_r)
   {
-    poly.verts[vert_f_ind_r] = read_var_from_m3d<std::int32_t, int>();
+    poly.verts[vert_f_ind_r] =
+      read_record_var_from_m3d<std::int32_t>(vert_rel_pos);
+    vert_rel_pos += c3d::polygon::vert_ind_size;
     poly.vertNorms[vert_f_ind_r] =
-      read_var_from_m3d<std::int32_t, int>();
+      read_record_var_from_m3d<std::int32_t>(vert_rel_pos);
+    vert_rel_pos += c3d::polygon::norm_ind_size;
   }
-
-  return poly;
+  m3d_data_cur_pos += vert_rel_pos;
 }
 
 void m3d_to_wavefront_obj_model::read_polygons(volInt::polyhedron &model)
 {
   for(std::size_t cur_poly = 0; cur_poly < model.numFaces; ++cur_poly)
   {
-    model.faces[cur_poly] = read_polygon(model, cur_poly);
+    read_polygon(model.faces[cur_poly], cur_poly);
   }
 }
 
@@ -528,27 +525,42 @@ volInt::polyhedron m3d_to_wavefront_obj_model::read_c3d(
 
   volInt::model_extreme_points discarded_extreme_points;
   discarded_extreme_points.max() =
-    read_vec_var_from_m3d_scaled<std::int32_t, double>(volInt::axes_num);
+    read_point_from_m3d_scaled<std::int32_t>();
   discarded_extreme_points.min() =
-    read_vec_var_from_m3d_scaled<std::int32_t, double>(volInt::axes_num);
+    read_point_from_m3d_scaled<std::int32_t>();
 
   volInt::model_offset offset_point(
-    read_vec_var_from_m3d_scaled<std::int32_t, double>(volInt::axes_num));
+    read_point_from_m3d_scaled<std::int32_t>());
 
   double discarded_rmax = read_var_from_m3d_scaled<std::int32_t, double>();
 
-  std::vector<int> discarded_phi_psi_tetta =
-    read_vec_var_from_m3d<std::int32_t, int>(volInt::axes_num);
+  // phi, psi and tetta are not used.
+  skip_m3d_data(sizeof(std::int32_t) * volInt::axes_num);
 
   double volume = read_var_from_m3d_scaled<double, double>(3.0);
-  std::vector<double> rcm =
-    read_vec_var_from_m3d_scaled<double, double>(volInt::axes_num);
+  point rcm = read_point_from_m3d_scaled<double>();
   std::vector<std::vector<double>> J =
     read_nest_vec_var_from_m3d_scaled<double, double>(volInt::axes_num,
                                                       volInt::axes_num,
                                                       5.0);
 
 
+  if(numVerts < 0 || numVertNorms < 0 || numFaces < 0)
+  {
+    throw std::runtime_error(
+      input_file_name_error + " file " +
+      input_m3d_path.string() + " has negative number of " +
+      "vertices, normals or polygons in c3d which ends at position " +
+      std::to_string(m3d_data_cur_pos) + ".");
+  }
+  // All vertices, normals, polygons and sorted polygon indices
+  // are checked at once before memory for them is allocated.
+  check_m3d_data_left(
+    c3d::vertex::size * numVerts +
+    c3d::normal::size * numVertNorms +
+    (c3d::polygon::general_info_size +
+     c3d::polygon::size_per_vertex * expected_vertices_per_poly +
+     c3d::polygon_sort_info::size) * numFaces);
 
   volInt::polyhedron cur_model(numVerts,
                                numVertNorms,
@@ -591,12 +603,47 @@ void m3d_to_wavefront_obj_model::save_c3d_as_wavefront_obj(
   c3d_models[wavefront_obj::obj_name::main].wavefront_obj_path =
     file_to_save.string();
 
-  save_volInt_as_wavefront_obj(c3d_models,
-                               file_to_save,
-                               output_file_name_error,
-                               float_precision_objs_string,
-                               expected_medium_vertex_size,
-                               expected_medium_normal_size);
+  std::string obj_data =
+    volInt_to_wavefront_obj_data(c3d_models,
+                                 float_precision_objs_string,
+                                 expected_medium_vertex_size,
+                                 expected_medium_normal_size);
+  save_file(file_to_save,
+            obj_data,
+            file_flag::none,
+            output_file_name_error);
+
+  if(flags & m3d_to_obj_flag::use_obj_binary_cache)
+  {
+    // Saving cache of saved file so it's ready
+    // when it's converted back to *.m3d/*.a3d.
+    // Cached model is parsed from data of saved file
+    // which is still in memory.
+    c3d::c3d_type cache_c3d_type = c3d::c3d_type::regular;
+    if(c3d_models[wavefront_obj::obj_name::main].numVertsPerPoly ==
+       c3d::bound_model_vertices_per_polygon)
+    {
+      cache_c3d_type = c3d::c3d_type::bound;
+    }
+    try
+    {
+      // Models are already converted in parallel jobs.
+      save_volInt_cache(
+        file_to_save,
+        output_file_name_error,
+        raw_obj_to_volInt_model(obj_data.data(),
+                                obj_data.size(),
+                                file_to_save,
+                                output_file_name_error,
+                                cache_c3d_type,
+                                volInt_cache::default_color_placeholder,
+                                1));
+    }
+    catch(std::exception &)
+    {
+      // Cache is optional so extraction doesn't fail without it.
+    }
+  }
 }
 
 void m3d_to_wavefront_obj_model::save_c3d_as_wavefront_obj(
@@ -624,8 +671,8 @@ void m3d_to_wavefront_obj_model::c3d_to_wavefront_obj(
 
 void m3d_to_wavefront_obj_model::read_m3d_header_data()
 {
-  std::vector<double> discarded_max_point =
-    read_vec_var_from_m3d_scaled<std::int32_t, double>(volInt::axes_num);
+  // max point is not used.
+  skip_m3d_data(sizeof(std::int32_t) * volInt::axes_num);
   double discarded_rmax = read_var_from_m3d_scaled<std::int32_t, double>();
 
   n_wheels = read_var_from_m3d<std::int32_t, int>();
@@ -640,8 +687,8 @@ void m3d_to_wavefront_obj_model::read_a3d_header_data()
 {
   n_models = read_var_from_m3d<std::int32_t, int>();
 
-  std::vector<double> discarded_max_point =
-    read_vec_var_from_m3d_scaled<std::int32_t, double>(volInt::axes_num);
+  // max point is not used.
+  skip_m3d_data(sizeof(std::int32_t) * volInt::axes_num);
   double discarded_rmax =
     read_var_from_m3d_scaled<std::int32_t, double>();
 
@@ -656,7 +703,7 @@ void m3d_to_wavefront_obj_model::read_m3d_wheel_data(
 {
   cur_wheel_data[wheel_id].steer = read_var_from_m3d<std::int32_t, int>();
   cur_wheel_data[wheel_id].r =
-    read_vec_var_from_m3d_scaled<double, double>(volInt::axes_num);
+    read_point_from_m3d_scaled<double>();
   cur_wheel_data[wheel_id].width =
     read_var_from_m3d_scaled<std::int32_t, double>();
   cur_wheel_data[wheel_id].radius =
@@ -756,7 +803,7 @@ volInt::polyhedron
     (cur_ghost_wheel.zmax() - cur_ghost_wheel.zmin()) / 2;
   double radius_multiplier = cur_wheel_data[wheel_id].radius / given_radius;
 
-  std::vector<double> multiplier =
+  point multiplier =
     {
       width_multiplier,
       radius_multiplier,
@@ -808,12 +855,12 @@ void m3d_to_wavefront_obj_model::get_ghost_wheels(
 
 
 void m3d_to_wavefront_obj_model::move_weapon_model(
-  std::vector<double> new_position,
+  point new_position,
   double new_angle,
   int weapon_id,
   volInt::polyhedron &weapon_model) const
 {
-  std::vector<double> weapon_offset = weapon_model.offset_point();
+  point weapon_offset = weapon_model.offset_point();
   volInt::rotate_point_by_axis(weapon_offset,
                                new_angle,
                                volInt::rotation_axis::y);
@@ -946,7 +993,7 @@ void m3d_to_wavefront_obj_model::move_debris_to_offset(
   volInt::polyhedron &main_debris_model =
     debris_model[wavefront_obj::obj_name::main];
 
-  std::vector<double> offset = main_debris_model.offset_point();
+  point offset = main_debris_model.offset_point();
 
   main_debris_model.move_model_to_point_inv_neg_vol(offset);
   if(center_of_mass_model)
@@ -999,7 +1046,7 @@ void m3d_to_wavefront_obj_model::save_m3d_debris_data(
 void m3d_to_wavefront_obj_model::read_m3d_weapon_slot(std::size_t slot_id)
 {
   cur_weapon_slot_data[slot_id].R_slot =
-    read_vec_var_from_m3d_scaled<std::int32_t, double>(volInt::axes_num);
+    read_point_from_m3d_scaled<std::int32_t>();
   cur_weapon_slot_data[slot_id].location_angle_of_slot =
     volInt::sicher_angle_to_radians(read_var_from_m3d<std::int32_t, int>());
   // In weapon_slots_existence only rightmost 3 bits are important.
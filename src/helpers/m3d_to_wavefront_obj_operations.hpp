@@ -10,10 +10,11 @@
 #include "file_operations.hpp"
 #include "vangers_cfg_operations.hpp"
 #include "wavefront_obj_operations.hpp"
+#include "volInt_cache_operations.hpp"
 #include "vangers_3d_model_operations.hpp"
+#include "thread_log.hpp"
 
 #include "volInt.hpp"
-#include "tiny_obj_loader.h"
 
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string.hpp>
@@ -27,6 +28,7 @@
 #include <iostream>
 #include <utility>
 #include <iterator>
+#include <numeric>
 #include <string>
 #include <vector>
 #include <unordered_set>
@@ -47,6 +49,7 @@ enum class m3d_to_obj_flag
   use_custom_volume_by_default = 3,
   use_custom_rcm_by_default = 4,
   use_custom_J_by_default = 5,
+  use_obj_binary_cache = 6,
 };
 
 // 1 digit left to dot + 1 dot + 8 expected digits right to dot + 4 exponent
@@ -99,6 +102,9 @@ public:
 
 private:
 
+  // *.m3d/*.a3d file is parsed in place.
+  file_view m3d_file;
+
   unsigned int float_precision_objs;
 
   bitflag<m3d_to_obj_flag> flags;
@@ -118,10 +124,41 @@ private:
 
 
 
+  // Throws if there are less than size bytes after m3d_data_cur_pos.
+  void check_m3d_data_left(std::size_t size) const;
+  void skip_m3d_data(std::size_t size);
+
+  // Reads value of record which starts at m3d_data_cur_pos.
+  // There is no bounds check,
+  // whole record must be checked by check_m3d_data_left() beforehand.
+  template<typename SOURCE>
+  SOURCE read_record_var_from_m3d(std::size_t rel_pos) const
+  {
+    return raw_bytes_to_num<SOURCE>(m3d_file.data(),
+                                    m3d_data_cur_pos + rel_pos);
+  }
+
+  template<typename SOURCE>
+  point read_record_point_from_m3d(std::size_t rel_pos,
+                                   double multiplier = 1.0) const
+  {
+    point pt;
+    for(std::size_t cur_coord = 0; cur_coord < volInt::axes_num; ++cur_coord)
+    {
+      pt[cur_coord] =
+        read_record_var_from_m3d<SOURCE>(rel_pos + sizeof(SOURCE) * cur_coord) *
+        multiplier;
+    }
+    return pt;
+  }
+
+
   template<typename SOURCE, typename DESTINATION>
   DESTINATION read_var_from_m3d()
   {
-    DESTINATION var = raw_bytes_to_num<SOURCE>(m3d_data, m3d_data_cur_pos);
+    check_m3d_data_left(sizeof(SOURCE));
+    DESTINATION var =
+      raw_bytes_to_num<SOURCE>(m3d_file.data(), m3d_data_cur_pos);
     m3d_data_cur_pos += sizeof(SOURCE);
     return var;
   }
@@ -139,8 +176,11 @@ private:
   template<typename SOURCE, typename DESTINATION>
   std::vector<DESTINATION> read_vec_var_from_m3d(std::size_t count)
   {
+    check_m3d_data_left(sizeof(SOURCE) * count);
     std::vector<SOURCE> vec_src =
-      raw_bytes_to_vec_num<SOURCE>(m3d_data, m3d_data_cur_pos, count);
+      raw_bytes_to_vec_num<SOURCE>(m3d_file.data(),
+                                   m3d_data_cur_pos,
+                                   count);
     std::vector<DESTINATION> vec_dest =
       cast_vec_var<SOURCE, DESTINATION>(vec_src);
     m3d_data_cur_pos += sizeof(SOURCE) * count;
@@ -158,12 +198,41 @@ private:
   }
 
 
+  // Coordinates are read one by one so no temporary vectors are created.
+  template<typename SOURCE>
+  point read_point_from_m3d()
+  {
+    point pt;
+    for(auto &&coord : pt)
+    {
+      coord = read_var_from_m3d<SOURCE, double>();
+    }
+    return pt;
+  }
+
+  template<typename SOURCE>
+  point read_point_from_m3d_scaled(double exp = 1.0)
+  {
+    point pt;
+    for(auto &&coord : pt)
+    {
+      coord = read_var_from_m3d_scaled<SOURCE, double>(exp);
+    }
+    return pt;
+  }
+
+
   template<typename SOURCE, typename DESTINATION>
   std::vector<std::vector<DESTINATION>> read_nest_vec_var_from_m3d(
     const std::vector<std::size_t> &count_map)
   {
+    check_m3d_data_left(
+      sizeof(SOURCE) *
+      std::accumulate(count_map.begin(), count_map.end(), std::size_t(0)));
     std::vector<std::vector<SOURCE>> nest_vec_src =
-      raw_bytes_to_nest_vec_num<SOURCE>(m3d_data, m3d_data_cur_pos, count_map);
+      raw_bytes_to_nest_vec_num<SOURCE>(m3d_file.data(),
+                                        m3d_data_cur_pos,
+                                        count_map);
     std::vector<std::vector<DESTINATION>> nest_vec_dest =
       cast_nest_vec_var<SOURCE, DESTINATION>(nest_vec_src);
     for(const auto count : count_map)
@@ -188,8 +257,9 @@ private:
   std::vector<std::vector<DESTINATION>> read_nest_vec_var_from_m3d(
     std::size_t count_vec, std::size_t count_el)
   {
+    check_m3d_data_left(sizeof(SOURCE) * count_vec * count_el);
     std::vector<std::vector<SOURCE>> nest_vec_src =
-      raw_bytes_to_nest_vec_num<SOURCE>(m3d_data,
+      raw_bytes_to_nest_vec_num<SOURCE>(m3d_file.data(),
                                         m3d_data_cur_pos,
                                         count_vec,
                                         count_el);
@@ -211,14 +281,13 @@ private:
 
 
 
-  std::vector<double> read_vertex();
+  // Records are decoded straight into preallocated arrays of model.
+  // Bounds of all records are checked by read_c3d() at once
+  // and discarded fields are skipped without reading.
   void read_vertices(volInt::polyhedron &model);
-
-  std::vector<double> read_normal(bitflag<normal_flag> flags);
   void read_normals(volInt::polyhedron &model);
 
-  volInt::face read_polygon(const volInt::polyhedron &model,
-                            std::size_t cur_poly);
+  void read_polygon(volInt::face &poly, std::size_t cur_poly);
   void read_polygons(volInt::polyhedron &model);
 
   void read_sorted_polygon_indices(volInt::polyhedron &model);
@@ -258,7 +327,7 @@ private:
     std::vector<volInt::polyhedron> &non_steer_ghost_wheels_models);
 
 
-  void move_weapon_model(std::vector<double> new_position,
+  void move_weapon_model(point new_position,
                          double new_angle,
                          int weapon_id,
                          volInt::polyhedron &weapon_model) const;
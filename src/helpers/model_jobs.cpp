@@ -0,0 +1,44 @@
+#include "model_jobs.hpp"
+
+
+
+namespace tractor_converter{
+namespace helpers{
+
+
+
+model_job::model_job(const vangers_3d_paths_game_dir::io_paths &io_paths_arg)
+: io_paths(&io_paths_arg)
+{
+}
+
+
+
+void add_model_job(thread_pool &pool_arg,
+                   model_job &job_arg,
+                   std::function<void()> convert_arg)
+{
+  model_job *job_ptr = &job_arg;
+  pool_arg.add_task(
+    [job_ptr, convert_arg]()
+    {
+      std::ostringstream job_log;
+      {
+        thread_log_redirect redirect(job_log);
+        try
+        {
+          convert_arg();
+        }
+        catch(...)
+        {
+          job_ptr->exception = std::current_exception();
+        }
+      }
+      job_ptr->log = job_log.str();
+    });
+}
+
+
+
+} // namespace helpers
+} // namespace tractor_converter
@@ -0,0 +1,110 @@
+#ifndef TRACTOR_CONVERTER_MODEL_JOBS_H
+#define TRACTOR_CONVERTER_MODEL_JOBS_H
+
+#include "thread_pool.hpp"
+#include "thread_log.hpp"
+#include "vangers_3d_model_operations.hpp"
+
+#include <exception>
+#include <stdexcept>
+
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+
+
+namespace tractor_converter{
+namespace helpers{
+
+
+
+// Conversion of single model which runs as task of thread_pool.
+// Messages and exception of conversion are saved in job
+// so models converted in parallel don't mix their output.
+// Modes derive their jobs from it to keep results of conversion.
+struct model_job
+{
+  model_job(const vangers_3d_paths_game_dir::io_paths &io_paths_arg);
+
+  const vangers_3d_paths_game_dir::io_paths *io_paths;
+
+  // Messages written to thread_log() by conversion.
+  std::string log;
+  // Set if conversion failed.
+  std::exception_ptr exception;
+};
+
+
+
+// Adds task to pool_arg which calls convert_arg
+// with thread_log() redirected to job_arg.log.
+// Exception thrown by convert_arg is saved in job_arg.exception.
+void add_model_job(thread_pool &pool_arg,
+                   model_job &job_arg,
+                   std::function<void()> convert_arg);
+
+
+
+// Job for each model of models_io_paths_arg.
+template<typename job_type>
+std::vector<job_type> get_model_jobs(
+  const std::unordered_map<std::string, vangers_3d_paths_game_dir::io_paths>
+    &models_io_paths_arg)
+{
+  std::vector<job_type> jobs;
+  jobs.reserve(models_io_paths_arg.size());
+  for(const auto &model_io_paths : models_io_paths_arg)
+  {
+    jobs.emplace_back(model_io_paths.second);
+  }
+  return jobs;
+}
+
+
+
+// Adds task for each of jobs_arg which calls convert_arg with that job.
+// convert_arg is copied since tasks may run after return.
+template<typename job_type, typename convert_type>
+void add_model_jobs(thread_pool &pool_arg,
+                    std::vector<job_type> &jobs_arg,
+                    const convert_type &convert_arg)
+{
+  for(auto &&job : jobs_arg)
+  {
+    job_type *job_ptr = &job;
+    add_model_job(pool_arg,
+                  job,
+                  [job_ptr, convert_arg]()
+                  {
+                    convert_arg(*job_ptr);
+                  });
+  }
+}
+
+
+
+// Must be called after all jobs are done.
+// Prints messages of jobs in the same order as serial conversion would.
+// finish_arg is called for each job right after its messages are printed.
+template<typename job_type, typename finish_type>
+void finish_model_jobs(const std::vector<job_type> &jobs_arg,
+                       const finish_type &finish_arg)
+{
+  for(const auto &job : jobs_arg)
+  {
+    std::cout << job.log;
+    finish_arg(job);
+  }
+  std::cout.flush();
+}
+
+
+
+} // namespace helpers
+} // namespace tractor_converter
+
+#endif // TRACTOR_CONVERTER_MODEL_JOBS_H
@@ -0,0 +1,124 @@
+#include "process_files.hpp"
+
+
+
+namespace tractor_converter{
+namespace helpers{
+
+
+
+std::vector<boost::filesystem::path> get_files(
+  const boost::filesystem::path &dir_arg)
+{
+  std::vector<boost::filesystem::path> files;
+  for(const auto &file : boost::filesystem::directory_iterator(dir_arg))
+  {
+    if(boost::filesystem::is_regular_file(file.status()))
+    {
+      files.push_back(file.path());
+    }
+  }
+  std::sort(files.begin(), files.end());
+  return files;
+}
+
+
+
+std::vector<boost::filesystem::path> get_files_with_ext(
+  const boost::filesystem::path &dir_arg,
+  const std::string &ext_arg)
+{
+  std::vector<boost::filesystem::path> files;
+  for(const auto &file : boost::filesystem::directory_iterator(dir_arg))
+  {
+    if(boost::filesystem::is_regular_file(file.status()) &&
+       boost::algorithm::to_lower_copy(file.path().extension().string()) ==
+         ext_arg)
+    {
+      files.push_back(file.path());
+    }
+  }
+  std::sort(files.begin(), files.end());
+  return files;
+}
+
+
+
+void process_files(
+  const std::vector<boost::filesystem::path> &files_arg,
+  std::size_t jobs_num_arg,
+  const std::function<void(std::size_t file_ind,
+                           const boost::filesystem::path &file)>
+    &process_file_arg)
+{
+  std::size_t files_num = files_arg.size();
+
+  // Messages are printed right away since there is nothing to mix with.
+  if(jobs_num_arg <= 1)
+  {
+    for(std::size_t file_ind = 0; file_ind < files_num; ++file_ind)
+    {
+      process_file_arg(file_ind, files_arg[file_ind]);
+    }
+    std::cout.flush();
+    return;
+  }
+
+  std::vector<std::string> logs(files_num);
+  std::vector<std::exception_ptr> exceptions(files_num);
+  // Index of the first failed file.
+  // Equal to files_num while there are no failures.
+  std::atomic<std::size_t> first_failed(files_num);
+
+  {
+    thread_pool pool(jobs_num_arg);
+    for(std::size_t file_ind = 0; file_ind < files_num; ++file_ind)
+    {
+      pool.add_task(
+        [&, file_ind]()
+        {
+          if(file_ind > first_failed)
+          {
+            return;
+          }
+
+          std::ostringstream file_log;
+          {
+            thread_log_redirect redirect(file_log);
+            try
+            {
+              process_file_arg(file_ind, files_arg[file_ind]);
+            }
+            catch(...)
+            {
+              exceptions[file_ind] = std::current_exception();
+              std::size_t cur_first_failed = first_failed;
+              while(file_ind < cur_first_failed &&
+                    !first_failed.compare_exchange_weak(cur_first_failed,
+                                                        file_ind))
+              {
+              }
+            }
+          }
+          logs[file_ind] = file_log.str();
+        });
+    }
+    pool.wait();
+  }
+
+  for(std::size_t file_ind = 0; file_ind < files_num; ++file_ind)
+  {
+    std::cout << logs[file_ind];
+    if(exceptions[file_ind])
+    {
+      std::cout.flush();
+      std::rethrow_exception(exceptions[file_ind]);
+    }
+  }
+  std::cout.flush();
+}
+
+
+
+} // namespace helpers
+} // namespace tractor_converter
@@ -0,0 +1,64 @@
+#ifndef TRACTOR_CONVERTER_PROCESS_FILES_H
+#define TRACTOR_CONVERTER_PROCESS_FILES_H
+
+#include "thread_pool.hpp"
+#include "thread_log.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/algorithm/string.hpp>
+
+#include <exception>
+#include <stdexcept>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+
+namespace tractor_converter{
+namespace helpers{
+
+
+
+// Regular files of directory sorted by path
+// so order doesn't depend on file system.
+std::vector<boost::filesystem::path> get_files(
+  const boost::filesystem::path &dir_arg);
+
+// Regular files of directory which have extension ext_arg.
+// Extension is compared in lowercase.
+// Files are sorted by path so order doesn't depend on file system.
+std::vector<boost::filesystem::path> get_files_with_ext(
+  const boost::filesystem::path &dir_arg,
+  const std::string &ext_arg);
+
+
+
+// Calls process_file_arg for each file using jobs_num_arg threads.
+// Each file must be independent from the others.
+//
+// With single thread it works the same way as simple loop over files
+// and messages are printed while files are processed.
+// Otherwise messages written to thread_log() while processing file
+// are printed after all files are done in order of files.
+// If processing of some file fails, files which were not started yet
+// are skipped and exception of the first failed file is rethrown.
+void process_files(
+  const std::vector<boost::filesystem::path> &files_arg,
+  std::size_t jobs_num_arg,
+  const std::function<void(std::size_t file_ind,
+                           const boost::filesystem::path &file)>
+    &process_file_arg);
+
+
+
+} // namespace helpers
+} // namespace tractor_converter
+
+#endif // TRACTOR_CONVERTER_PROCESS_FILES_H
@@ -18,17 +18,26 @@ namespace helpers{
 
 
 
+// Functions which take "const char *bytes" are used
+// to read data in place, for example from file_view.
+
 template<typename T>
-T raw_bytes_to_num(const std::string &bytes, std::size_t pos_to_read)
+T raw_bytes_to_num(const char *bytes, std::size_t pos_to_read)
 {
   T num;
-  std::memcpy(&num, &bytes[pos_to_read], sizeof(T));
+  std::memcpy(&num, bytes + pos_to_read, sizeof(T));
   return num;
 }
 
+template<typename T>
+T raw_bytes_to_num(const std::string &bytes, std::size_t pos_to_read)
+{
+  return raw_bytes_to_num<T>(bytes.data(), pos_to_read);
+}
+
 template<typename T>
 std::vector<T> raw_bytes_to_vec_num(
-  const std::string &bytes, std::size_t pos_to_read, std::size_t count_el)
+  const char *bytes, std::size_t pos_to_read, std::size_t count_el)
 {
   std::vector<T> vec(count_el);
   for(auto &&num : vec)
@@ -39,9 +48,16 @@ std::vector<T> raw_bytes_to_vec_num(
   return vec;
 }
 
+template<typename T>
+std::vector<T> raw_bytes_to_vec_num(
+  const std::string &bytes, std::size_t pos_to_read, std::size_t count_el)
+{
+  return raw_bytes_to_vec_num<T>(bytes.data(), pos_to_read, count_el);
+}
+
 template<typename T>
 std::vector<std::vector<T>> raw_bytes_to_nest_vec_num(
-  const std::string &bytes,
+  const char *bytes,
   std::size_t pos_to_read,
   const std::vector<std::size_t> &count_map)
 {
@@ -60,6 +76,15 @@ template<typename T>
 std::vector<std::vector<T>> raw_bytes_to_nest_vec_num(
   const std::string &bytes,
   std::size_t pos_to_read,
+  const std::vector<std::size_t> &count_map)
+{
+  return raw_bytes_to_nest_vec_num<T>(bytes.data(), pos_to_read, count_map);
+}
+
+template<typename T>
+std::vector<std::vector<T>> raw_bytes_to_nest_vec_num(
+  const char *bytes,
+  std::size_t pos_to_read,
   std::size_t count_vec,
   std::size_t count_el)
 {
@@ -72,14 +97,35 @@ std::vector<std::vector<T>> raw_bytes_to_nest_vec_num(
   return nest_vec;
 }
 
+template<typename T>
+std::vector<std::vector<T>> raw_bytes_to_nest_vec_num(
+  const std::string &bytes,
+  std::size_t pos_to_read,
+  std::size_t count_vec,
+  std::size_t count_el)
+{
+  return raw_bytes_to_nest_vec_num<T>(bytes.data(),
+                                      pos_to_read,
+                                      count_vec,
+                                      count_el);
+}
+
 
 
+template<typename T>
+void num_to_raw_bytes(const T num,
+                      char *bytes,
+                      std::size_t pos_to_write)
+{
+  std::memcpy(bytes + pos_to_write, &num, sizeof(T));
+}
+
 template<typename T>
 void num_to_raw_bytes(const T num,
                       std::string &bytes,
                       std::size_t pos_to_write)
 {
-  std::memcpy(&bytes[pos_to_write], &num, sizeof(T));
+  num_to_raw_bytes<T>(num, &bytes[0], pos_to_write);
 }
 
 template<typename T>
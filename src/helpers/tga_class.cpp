@@ -8,7 +8,7 @@ namespace helpers{
 
 
 std::size_t get_color_size(
-  const std::string &bytes,
+  const char *bytes,
   const std::size_t image_start_pos,
   const std::string &path_string,
   const bitflag<error_handling> error_flags)
@@ -35,10 +35,22 @@ std::size_t get_color_size(
   return color_size;
 }
 
+std::size_t get_color_size(
+  const std::string &bytes,
+  const std::size_t image_start_pos,
+  const std::string &path_string,
+  const bitflag<error_handling> error_flags)
+{
+  return get_color_size(bytes.data(),
+                        image_start_pos,
+                        path_string,
+                        error_flags);
+}
+
 
 
 std::size_t get_colors_num(
-  const std::string &bytes,
+  const char *bytes,
   const std::size_t image_start_pos,
   const std::string &path_string,
   const bitflag<error_handling> error_flags)
@@ -65,23 +77,146 @@ std::size_t get_colors_num(
   return colors_num;
 }
 
+std::size_t get_colors_num(
+  const std::string &bytes,
+  const std::size_t image_start_pos,
+  const std::string &path_string,
+  const bitflag<error_handling> error_flags)
+{
+  return get_colors_num(bytes.data(),
+                        image_start_pos,
+                        path_string,
+                        error_flags);
+}
 
 
-tga::tga(const std::string &bytes_arg,
+
+std::size_t tga_rle_decode(const char *src,
+                           std::size_t src_size,
+                           char *dst,
+                           std::size_t dst_size,
+                           const std::string &file_name_error)
+{
+  std::size_t src_pos = 0;
+  std::size_t dst_pos = 0;
+  while(dst_pos < dst_size)
+  {
+    if(src_pos >= src_size)
+    {
+      throw std::runtime_error(
+        "Image " + file_name_error + " has RLE compressed data "
+        "which ends after " + std::to_string(dst_pos) + " pixels "
+        "while image has " + std::to_string(dst_size) + " pixels.");
+    }
+    unsigned char packet_header = static_cast<unsigned char>(src[src_pos]);
+    ++src_pos;
+    std::size_t pixels_num =
+      (packet_header & ~tga_rle_packet_run_flag) + 1;
+    if(pixels_num > dst_size - dst_pos)
+    {
+      throw std::runtime_error(
+        "Image " + file_name_error + " has RLE packet "
+        "at byte " + std::to_string(src_pos - 1) + " of compressed data "
+        "which goes past the end of image.");
+    }
+
+    if(packet_header & tga_rle_packet_run_flag)
+    {
+      if(src_pos >= src_size)
+      {
+        throw std::runtime_error(
+          "Image " + file_name_error + " has RLE compressed data "
+          "which ends in the middle of packet.");
+      }
+      std::memset(dst + dst_pos, src[src_pos], pixels_num);
+      ++src_pos;
+    }
+    else
+    {
+      if(pixels_num > src_size - src_pos)
+      {
+        throw std::runtime_error(
+          "Image " + file_name_error + " has RLE compressed data "
+          "which ends in the middle of packet.");
+      }
+      std::memcpy(dst + dst_pos, src + src_pos, pixels_num);
+      src_pos += pixels_num;
+    }
+    dst_pos += pixels_num;
+  }
+  return src_pos;
+}
+
+
+
+void tga_rle_encode(const char *src,
+                    std::size_t width,
+                    std::size_t height,
+                    std::string &dst)
+{
+  for(std::size_t current_y = 0; current_y < height; ++current_y)
+  {
+    const char *row = src + current_y * width;
+    std::size_t current_x = 0;
+    while(current_x < width)
+    {
+      std::size_t max_pixels =
+        std::min(width - current_x, tga_rle_packet_max_pixels);
+
+      std::size_t run_size = 1;
+      while(run_size < max_pixels &&
+            row[current_x + run_size] == row[current_x])
+      {
+        ++run_size;
+      }
+      // Runs shorter than 3 pixels are stored in raw packets
+      // unless nothing else is left in the row.
+      if(run_size > 2 || run_size == max_pixels)
+      {
+        dst.push_back(static_cast<char>(
+          tga_rle_packet_run_flag | (run_size - 1)));
+        dst.push_back(row[current_x]);
+        current_x += run_size;
+        continue;
+      }
+
+      // Raw packet ends where run of at least 3 pixels starts.
+      std::size_t raw_size = 1;
+      while(raw_size < max_pixels)
+      {
+        std::size_t next_x = current_x + raw_size;
+        if(next_x + 2 < width &&
+           row[next_x] == row[next_x + 1] &&
+           row[next_x] == row[next_x + 2])
+        {
+          break;
+        }
+        ++raw_size;
+      }
+      dst.push_back(static_cast<char>(raw_size - 1));
+      dst.append(row + current_x, raw_size);
+      current_x += raw_size;
+    }
+  }
+}
+
+
+
+tga::tga(const char *bytes_arg,
          const std::size_t image_start_pos,
          const std::string &file_name_error)
 {
-  const std::string *bytes = &bytes_arg;
+  const char *bytes = bytes_arg;
 
   ID_field_length =
     static_cast<std::size_t>(
       static_cast<unsigned char>(
-        (*bytes)[image_start_pos + tga_id_length_pos]));
+        bytes[image_start_pos + tga_id_length_pos]));
 
   color_map_type =
     static_cast<int>(
       static_cast<unsigned char>(
-        (*bytes)[image_start_pos + tga_color_map_type_pos]));
+        bytes[image_start_pos + tga_color_map_type_pos]));
   if(color_map_type != tga_color_map_type_expected)
   {
     std::string err_msg =
@@ -101,8 +236,9 @@ tga::tga(const std::string &bytes_arg,
   image_type =
     static_cast<int>(
       static_cast<unsigned char>(
-        (*bytes)[image_start_pos + tga_image_type_pos]));
-  if(image_type != tga_image_type_expected)
+        bytes[image_start_pos + tga_image_type_pos]));
+  if(image_type != tga_image_type_expected &&
+     image_type != tga_image_type_rle)
   {
     std::string err_msg =
       "Image " + file_name_error +
@@ -114,12 +250,29 @@ tga::tga(const std::string &bytes_arg,
     err_msg.append(
       ".\n"
       "Expected image type " + std::to_string(tga_image_type_expected) +
-      " which means \"" + image_types.at(tga_image_type_expected) + "\".\n");
+      " which means \"" + image_types.at(tga_image_type_expected) + "\" "
+      "or " + std::to_string(tga_image_type_rle) +
+      " which means \"" + image_types.at(tga_image_type_rle) + "\".\n");
     throw std::runtime_error(err_msg);
   }
+  if(image_type == tga_image_type_rle)
+  {
+    std::size_t pixel_depth =
+      static_cast<std::size_t>(
+        static_cast<unsigned char>(
+          bytes[image_start_pos + tga_image_specification_pixel_depth_pos]));
+    if(pixel_depth != tga_rle_pixel_depth_expected)
+    {
+      throw std::runtime_error(
+        "Image " + file_name_error + " is RLE compressed and has " +
+        std::to_string(pixel_depth) + " bits per pixel while only " +
+        std::to_string(tga_rle_pixel_depth_expected) +
+        " bits per pixel images are supported.");
+    }
+  }
 
-  color_size = get_color_size(*bytes, image_start_pos, file_name_error);
-  colors_num = get_colors_num(*bytes, image_start_pos, file_name_error);
+  color_size = get_color_size(bytes, image_start_pos, file_name_error);
+  colors_num = get_colors_num(bytes, image_start_pos, file_name_error);
 
   pal_size = colors_num * color_size;
 
@@ -127,7 +280,7 @@ tga::tga(const std::string &bytes_arg,
   pal_start_pos = image_start_pos + tga_header_size + ID_field_length;
 
   width_height =
-    bytes->substr(image_start_pos + tga_coords_pos, tga_coords_size);
+    std::string(bytes + image_start_pos + tga_coords_pos, tga_coords_size);
 
   width =  raw_bytes_to_num<std::uint16_t>(width_height, 0);
   height = raw_bytes_to_num<std::uint16_t>(width_height, 2);
@@ -137,6 +290,46 @@ tga::tga(const std::string &bytes_arg,
   raw_bitmap_start_pos = pal_start_pos + pal_size;
 }
 
+tga::tga(const std::string &bytes_arg,
+         const std::size_t image_start_pos,
+         const std::string &file_name_error)
+: tga(bytes_arg.data(), image_start_pos, file_name_error)
+{
+}
+
+
+
+void tga_decompress(std::string &bytes,
+                    const std::size_t image_start_pos,
+                    tga &tga_image,
+                    const std::string &file_name_error)
+{
+  if(tga_image.image_type != tga_image_type_rle)
+  {
+    return;
+  }
+  if(tga_image.raw_bitmap_start_pos > bytes.size())
+  {
+    throw std::runtime_error(
+      "Image " + file_name_error + " ends before its image data.");
+  }
+
+  std::string decoded(tga_image.raw_bitmap_size, '\0');
+  tga_rle_decode(bytes.data() + tga_image.raw_bitmap_start_pos,
+                 bytes.size() - tga_image.raw_bitmap_start_pos,
+                 &decoded[0],
+                 decoded.size(),
+                 file_name_error);
+  bytes.replace(tga_image.raw_bitmap_start_pos,
+                std::string::npos,
+                decoded);
+
+  bytes.replace(image_start_pos + tga_image_type_pos,
+                tga_image_type_str.size(),
+                tga_image_type_str);
+  tga_image.image_type = tga_image_type_expected;
+}
+
 
 
 } // namespace helpers
@@ -12,6 +12,8 @@
 
 #include <climits>
 #include <cstddef>
+#include <cstring>
+#include <algorithm>
 #include <string>
 
 
@@ -21,22 +23,52 @@ namespace helpers{
 
 
 
+std::size_t get_color_size(
+  const char *bytes,
+  const std::size_t image_start_pos,
+  const std::string &path_string,
+  const bitflag<error_handling> error_flags = error_handling::throw_exception);
 std::size_t get_color_size(
   const std::string &bytes,
   const std::size_t image_start_pos,
   const std::string &path_string,
   const bitflag<error_handling> error_flags = error_handling::throw_exception);
 
+std::size_t get_colors_num(
+  const char *bytes,
+  const std::size_t image_start_pos,
+  const std::string &path_string,
+  const bitflag<error_handling> error_flags = error_handling::throw_exception);
 std::size_t get_colors_num(
   const std::string &bytes,
   const std::size_t image_start_pos,
   const std::string &path_string,
   const bitflag<error_handling> error_flags = error_handling::throw_exception);
 
+// Decodes RLE compressed 8 bits per pixel image data
+// from [src, src + src_size) into dst_size bytes of dst.
+// Returns number of bytes of src which were read.
+std::size_t tga_rle_decode(const char *src,
+                           std::size_t src_size,
+                           char *dst,
+                           std::size_t dst_size,
+                           const std::string &file_name_error);
+
+// Appends RLE compressed 8 bits per pixel image data to dst.
+// Packets don't cross rows of the image.
+void tga_rle_encode(const char *src,
+                    std::size_t width,
+                    std::size_t height,
+                    std::string &dst);
+
 struct tga
 {
   public:
 
+  // bytes_arg may point to the data of file_view.
+  tga(const char *bytes_arg,
+      const std::size_t image_start_pos,
+      const std::string &file_name_error);
   tga(const std::string &bytes_arg,
       const std::size_t image_start_pos,
       const std::string &file_name_error);
@@ -64,6 +96,15 @@ struct tga
 
 };
 
+// If tga_image is RLE compressed, replaces compressed image data
+// in bytes with decoded one and changes image type to uncompressed,
+// so the image can be processed the same way as uncompressed one.
+// Data after image data is removed.
+void tga_decompress(std::string &bytes,
+                    const std::size_t image_start_pos,
+                    tga &tga_image,
+                    const std::string &file_name_error);
+
 
 
 } // namespace helpers
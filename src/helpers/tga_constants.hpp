@@ -47,6 +47,13 @@ const std::size_t tga_coords_size = 4;
 const int tga_color_map_type_expected = 1;
 const int tga_color_map_type_empty = 0;
 const int tga_image_type_expected = 1;
+const int tga_image_type_rle = 9;
+// Only 8 bits per pixel images can be RLE compressed.
+const std::size_t tga_rle_pixel_depth_expected = 8;
+// Highest bit of packet header is set for run-length packets.
+// Lower 7 bits store number of pixels in packet minus 1.
+const unsigned char tga_rle_packet_run_flag = 0x80;
+const std::size_t tga_rle_packet_max_pixels = 128;
 const std::unordered_map<int, std::string> image_types =
   {
     {0 , "no image data is present"},
@@ -65,6 +72,7 @@ const std::unordered_map<int, std::string> image_types =
 const std::string tga_id_length_str("\0", 1);
 const std::string tga_color_map_type_str("\x01", 1);
 const std::string tga_image_type_str("\x01", 1);
+const std::string tga_image_type_rle_str("\x09", 1);
 
 
 
@@ -91,6 +99,12 @@ const std::string tga_image_specification_height_str("\0\0", 2);
 const std::string tga_image_specification_pixel_depth_str("\x08", 1);
 // Needed for right angle.
 const std::string tga_image_specification_image_descriptor_str("\x20", 1);
+// Same but rows are stored from bottom to top.
+const std::string tga_image_specification_image_descriptor_bottom_str(
+  "\0", 1);
+// Bits of image descriptor which specify origin of the image.
+const unsigned char tga_image_descriptor_right_to_left = 0x10;
+const unsigned char tga_image_descriptor_top_to_bottom = 0x20;
 
 const std::string tga_image_specification_str =
   tga_image_specification_x_origin_str +
@@ -0,0 +1,39 @@
+#include "thread_log.hpp"
+
+
+
+namespace tractor_converter{
+namespace helpers{
+
+
+
+thread_local std::ostream *thread_log_stream = nullptr;
+
+
+
+std::ostream &thread_log()
+{
+  if(thread_log_stream)
+  {
+    return *thread_log_stream;
+  }
+  return std::cout;
+}
+
+
+
+thread_log_redirect::thread_log_redirect(std::ostream &stream)
+: prev_stream(thread_log_stream)
+{
+  thread_log_stream = &stream;
+}
+
+thread_log_redirect::~thread_log_redirect()
+{
+  thread_log_stream = prev_stream;
+}
+
+
+
+} // namespace helpers
+} // namespace tractor_converter
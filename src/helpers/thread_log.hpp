@@ -0,0 +1,45 @@
+#ifndef TRACTOR_CONVERTER_THREAD_LOG_H
+#define TRACTOR_CONVERTER_THREAD_LOG_H
+
+#include <iostream>
+#include <ostream>
+
+
+
+namespace tractor_converter{
+namespace helpers{
+
+
+
+// Stream for messages of conversion running in current thread.
+// It is std::cout unless redirected with thread_log_redirect.
+std::ostream &thread_log();
+
+
+
+// Redirects thread_log() of current thread to another stream
+// while object exists.
+// Used to keep messages of files converted in parallel from mixing.
+class thread_log_redirect
+{
+
+public:
+
+  thread_log_redirect(std::ostream &stream);
+  ~thread_log_redirect();
+
+  thread_log_redirect(const thread_log_redirect &) = delete;
+  thread_log_redirect &operator=(const thread_log_redirect &) = delete;
+
+private:
+
+  std::ostream *prev_stream;
+
+};
+
+
+
+} // namespace helpers
+} // namespace tractor_converter
+
+#endif // TRACTOR_CONVERTER_THREAD_LOG_H
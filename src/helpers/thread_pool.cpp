@@ -0,0 +1,200 @@
+#include "thread_pool.hpp"
+
+
+
+namespace tractor_converter{
+namespace helpers{
+
+
+
+std::size_t get_jobs_num(std::size_t jobs_option)
+{
+  if(jobs_option)
+  {
+    return jobs_option;
+  }
+  std::size_t hardware_threads = std::thread::hardware_concurrency();
+  if(!hardware_threads)
+  {
+    return 1;
+  }
+  return hardware_threads;
+}
+
+
+
+thread_pool::thread_pool(std::size_t threads_num_arg)
+: m_threads_num(threads_num_arg ? threads_num_arg : 1),
+  next_queue(0),
+  queued_tasks(0),
+  unfinished_tasks(0),
+  stop(false)
+{
+  if(m_threads_num == 1)
+  {
+    return;
+  }
+
+  queues.reserve(m_threads_num);
+  for(std::size_t worker_id = 0; worker_id < m_threads_num; ++worker_id)
+  {
+    queues.emplace_back(new worker_queue());
+  }
+
+  workers.reserve(m_threads_num);
+  for(std::size_t worker_id = 0; worker_id < m_threads_num; ++worker_id)
+  {
+    workers.emplace_back(&thread_pool::worker_loop, this, worker_id);
+  }
+}
+
+
+
+thread_pool::~thread_pool()
+{
+  {
+    std::lock_guard<std::mutex> lock(state_mutex);
+    stop = true;
+  }
+  task_added.notify_all();
+  for(auto &&worker : workers)
+  {
+    worker.join();
+  }
+}
+
+
+
+void thread_pool::add_task(std::function<void()> task)
+{
+  if(m_threads_num == 1)
+  {
+    run_task(task);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(state_mutex);
+    {
+      worker_queue &queue = *queues[next_queue];
+      std::lock_guard<std::mutex> queue_lock(queue.mutex);
+      queue.tasks.push_back(std::move(task));
+    }
+    next_queue = (next_queue + 1) % m_threads_num;
+    ++queued_tasks;
+    ++unfinished_tasks;
+  }
+  task_added.notify_one();
+}
+
+
+
+void thread_pool::wait()
+{
+  {
+    std::unique_lock<std::mutex> lock(state_mutex);
+    all_tasks_done.wait(lock, [this]{ return !unfinished_tasks; });
+  }
+
+  if(first_exception)
+  {
+    std::exception_ptr to_rethrow = first_exception;
+    first_exception = nullptr;
+    std::rethrow_exception(to_rethrow);
+  }
+}
+
+
+
+std::size_t thread_pool::threads_num() const
+{
+  return m_threads_num;
+}
+
+
+
+bool thread_pool::pop_task(std::size_t worker_id,
+                           std::function<void()> &task)
+{
+  {
+    worker_queue &own_queue = *queues[worker_id];
+    std::lock_guard<std::mutex> queue_lock(own_queue.mutex);
+    if(!own_queue.tasks.empty())
+    {
+      task = std::move(own_queue.tasks.front());
+      own_queue.tasks.pop_front();
+      return true;
+    }
+  }
+
+  for(std::size_t offset = 1; offset < m_threads_num; ++offset)
+  {
+    worker_queue &victim_queue = *queues[(worker_id + offset) % m_threads_num];
+    std::lock_guard<std::mutex> queue_lock(victim_queue.mutex);
+    if(!victim_queue.tasks.empty())
+    {
+      task = std::move(victim_queue.tasks.back());
+      victim_queue.tasks.pop_back();
+      return true;
+    }
+  }
+  return false;
+}
+
+
+
+void thread_pool::run_task(std::function<void()> &task)
+{
+  try
+  {
+    task();
+  }
+  catch(...)
+  {
+    std::lock_guard<std::mutex> lock(state_mutex);
+    if(!first_exception)
+    {
+      first_exception = std::current_exception();
+    }
+  }
+}
+
+
+
+void thread_pool::worker_loop(std::size_t worker_id)
+{
+  std::function<void()> task;
+  while(true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(state_mutex);
+      task_added.wait(lock, [this]{ return stop || queued_tasks; });
+      if(!queued_tasks)
+      {
+        return;
+      }
+      // Reserving task so it's guaranteed to be found in one of the queues.
+      --queued_tasks;
+    }
+
+    while(!pop_task(worker_id, task))
+    {
+    }
+    run_task(task);
+    task = nullptr;
+
+    {
+      std::lock_guard<std::mutex> lock(state_mutex);
+      --unfinished_tasks;
+      if(!unfinished_tasks)
+      {
+        all_tasks_done.notify_all();
+      }
+    }
+  }
+}
+
+
+
+} // namespace helpers
+} // namespace tractor_converter
@@ -0,0 +1,92 @@
+#ifndef TRACTOR_CONVERTER_THREAD_POOL_H
+#define TRACTOR_CONVERTER_THREAD_POOL_H
+
+#include <exception>
+#include <stdexcept>
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+
+
+namespace tractor_converter{
+namespace helpers{
+
+
+
+// Returns number of threads to use for "jobs" option.
+// 0 means number of hardware threads.
+std::size_t get_jobs_num(std::size_t jobs_option);
+
+
+
+// Work-stealing thread pool.
+// Each worker has its own queue of tasks.
+// When own queue is empty, worker steals tasks from the queues of others.
+// If pool has only 1 thread, tasks are executed right away
+// in the calling thread so output is exactly the same
+// as without the pool.
+class thread_pool
+{
+
+public:
+
+  thread_pool(std::size_t threads_num_arg);
+  ~thread_pool();
+
+  thread_pool(const thread_pool &) = delete;
+  thread_pool &operator=(const thread_pool &) = delete;
+
+  void add_task(std::function<void()> task);
+
+  // Blocks until all added tasks are done.
+  // Rethrows first exception which was thrown by any task.
+  void wait();
+
+  std::size_t threads_num() const;
+
+private:
+
+  struct worker_queue
+  {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  std::size_t m_threads_num;
+
+  std::vector<std::unique_ptr<worker_queue>> queues;
+  std::vector<std::thread> workers;
+  std::size_t next_queue;
+
+  std::mutex state_mutex;
+  std::condition_variable task_added;
+  std::condition_variable all_tasks_done;
+  // Tasks which are in queues and not yet reserved by any worker.
+  std::size_t queued_tasks;
+  // Tasks which are in queues or being executed.
+  std::size_t unfinished_tasks;
+  bool stop;
+  std::exception_ptr first_exception;
+
+  // Takes task from the front of own queue
+  // or steals it from the back of the queue of another worker.
+  bool pop_task(std::size_t worker_id, std::function<void()> &task);
+  void run_task(std::function<void()> &task);
+  void worker_loop(std::size_t worker_id);
+
+};
+
+
+
+} // namespace helpers
+} // namespace tractor_converter
+
+#endif // TRACTOR_CONVERTER_THREAD_POOL_H
@@ -7,5 +7,368 @@ namespace helpers{
 
 
 
+// Decimal digits are calculated exactly from mantissa and exponent of double.
+// num * 10^precision == mantissa * 5^precision * 2^(exponent + precision),
+// so mantissa * 5^precision must fit in float_digits_uint.
+#if defined(__SIZEOF_INT128__)
+typedef unsigned __int128 float_digits_uint;
+const int float_digits_max_precision = 27;
+#else
+typedef std::uint64_t float_digits_uint;
+const int float_digits_max_precision = 4;
+#endif
+
+const int float_digits_uint_bits =
+  std::numeric_limits<float_digits_uint>::digits;
+const int double_mantissa_bits = std::numeric_limits<double>::digits;
+
+// Enough for sign, 39 digits of 128-bit integer, dot and zero padding.
+const std::size_t float_digits_buf_size = 80;
+
+
+
+struct float_digits_tables
+{
+  float_digits_tables()
+  {
+    pow5[0] = 1;
+    pow10[0] = 1;
+    for(int cur_pow = 1; cur_pow <= float_digits_max_precision; ++cur_pow)
+    {
+      pow5[cur_pow] = pow5[cur_pow - 1] * 5;
+      pow10[cur_pow] = pow10[cur_pow - 1] * 10;
+    }
+  }
+
+  float_digits_uint pow5[float_digits_max_precision + 1];
+  float_digits_uint pow10[float_digits_max_precision + 1];
+};
+
+
+
+const float_digits_tables &get_float_digits_tables()
+{
+  static const float_digits_tables tables;
+  return tables;
+}
+
+
+
+int float_digits_bit_length(float_digits_uint num)
+{
+  int bit_length = 0;
+  while(num != 0)
+  {
+    num >>= 1;
+    ++bit_length;
+  }
+  return bit_length;
+}
+
+
+
+// Sets digits to abs_num * 10^precision rounded half to even.
+// Returns false if result doesn't fit in float_digits_uint.
+bool float_digits_get(double abs_num,
+                      int precision,
+                      float_digits_uint &digits)
+{
+  if(abs_num == 0.0)
+  {
+    digits = 0;
+    return true;
+  }
+
+  int exponent;
+  double fraction = std::frexp(abs_num, &exponent);
+  float_digits_uint mantissa =
+    static_cast<std::uint64_t>(std::ldexp(fraction, double_mantissa_bits));
+  exponent -= double_mantissa_bits;
+
+  float_digits_uint product =
+    mantissa * get_float_digits_tables().pow5[precision];
+  int product_bits = float_digits_bit_length(product);
+  int shift = exponent + precision;
+
+  if(shift >= 0)
+  {
+    if(product_bits + shift >= float_digits_uint_bits)
+    {
+      return false;
+    }
+    digits = product << shift;
+    return true;
+  }
+
+  shift = -shift;
+  if(shift > product_bits)
+  {
+    // Less than 0.5.
+    digits = 0;
+    return true;
+  }
+
+  float_digits_uint remainder_mask =
+    (static_cast<float_digits_uint>(1) << shift) - 1;
+  float_digits_uint half = static_cast<float_digits_uint>(1) << (shift - 1);
+  float_digits_uint remainder = product & remainder_mask;
+  digits = product >> shift;
+  if(remainder > half || (remainder == half && (digits & 1)))
+  {
+    ++digits;
+  }
+  return true;
+}
+
+
+
+// Writes digits as fixed-point number with precision digits after dot.
+// Returns number of written chars.
+std::size_t float_digits_write(bool negative,
+                               float_digits_uint digits,
+                               int precision,
+                               char *buf)
+{
+  char reversed[float_digits_buf_size];
+  int reversed_size = 0;
+
+  while(digits > std::numeric_limits<std::uint64_t>::max())
+  {
+    reversed[reversed_size++] = static_cast<char>('0' + digits % 10);
+    digits /= 10;
+  }
+  std::uint64_t digits_64 = static_cast<std::uint64_t>(digits);
+  do
+  {
+    reversed[reversed_size++] = static_cast<char>('0' + digits_64 % 10);
+    digits_64 /= 10;
+  }
+  while(digits_64 != 0);
+  while(reversed_size < precision + 1)
+  {
+    reversed[reversed_size++] = '0';
+  }
+
+  std::size_t buf_size = 0;
+  if(negative)
+  {
+    buf[buf_size++] = '-';
+  }
+  for(int cur_digit = reversed_size - 1;
+      cur_digit >= precision;
+      --cur_digit)
+  {
+    buf[buf_size++] = reversed[cur_digit];
+  }
+  if(precision > 0)
+  {
+    buf[buf_size++] = '.';
+    for(int cur_digit = precision - 1; cur_digit >= 0; --cur_digit)
+    {
+      buf[buf_size++] = reversed[cur_digit];
+    }
+  }
+  return buf_size;
+}
+
+
+
+void to_string_fixed(double num_to_convert,
+                     int precision,
+                     std::string &string_to_modify)
+{
+  float_digits_uint digits;
+  if(!std::isfinite(num_to_convert) ||
+     precision < 0 ||
+     precision > float_digits_max_precision ||
+     !float_digits_get(std::fabs(num_to_convert), precision, digits))
+  {
+    to_string_sprintf<double>(num_to_convert,
+                              "%." + std::to_string(precision) + "f",
+                              string_to_modify);
+    return;
+  }
+
+  char buf[float_digits_buf_size];
+  string_to_modify.append(buf,
+                          float_digits_write(std::signbit(num_to_convert),
+                                             digits,
+                                             precision,
+                                             buf));
+}
+
+
+
+void to_string_general(double num_to_convert,
+                       int precision,
+                       std::string &string_to_modify)
+{
+  if(precision == 0)
+  {
+    precision = 1;
+  }
+  double abs_num = std::fabs(num_to_convert);
+
+  // Precision for style f is precision - 1 - exponent
+  // where exponent is taken from number rounded to precision digits.
+  // Style e is used when exponent is less than -4 or not less than precision.
+  // Since style e is rare in converted files it is passed to std::sprintf.
+  bool fast_path = std::isfinite(num_to_convert) &&
+                   precision > 0 &&
+                   precision <= float_digits_max_precision;
+  float_digits_uint digits = 0;
+  int fixed_precision = precision - 1;
+  if(fast_path && abs_num != 0.0)
+  {
+    const float_digits_tables &tables = get_float_digits_tables();
+    fixed_precision -= static_cast<int>(std::floor(std::log10(abs_num)));
+    // Guess from log10 may be off by one
+    // and rounding may add one more digit.
+    fast_path = false;
+    for(int attempt = 0; attempt < 3; ++attempt)
+    {
+      if(fixed_precision < 0 ||
+         fixed_precision > precision + 3 ||
+         fixed_precision > float_digits_max_precision ||
+         !float_digits_get(abs_num, fixed_precision, digits))
+      {
+        break;
+      }
+      if(digits >= tables.pow10[precision])
+      {
+        --fixed_precision;
+      }
+      else if(digits < tables.pow10[precision - 1])
+      {
+        ++fixed_precision;
+      }
+      else
+      {
+        fast_path = true;
+        break;
+      }
+    }
+  }
+
+  if(!fast_path)
+  {
+    to_string_sprintf<double>(num_to_convert,
+                              "%." + std::to_string(precision) + "g",
+                              string_to_modify);
+    return;
+  }
+
+  char buf[float_digits_buf_size];
+  std::size_t buf_size = float_digits_write(std::signbit(num_to_convert),
+                                            digits,
+                                            fixed_precision,
+                                            buf);
+  // Trailing zeros and dot are removed.
+  if(fixed_precision > 0)
+  {
+    while(buf[buf_size - 1] == '0')
+    {
+      --buf_size;
+    }
+    if(buf[buf_size - 1] == '.')
+    {
+      --buf_size;
+    }
+  }
+  string_to_modify.append(buf, buf_size);
+}
+
+
+
+void to_string_int(int num_to_convert, std::string &string_to_modify)
+{
+  char reversed[std::numeric_limits<int>::digits10 + 2];
+  std::size_t reversed_size = 0;
+  unsigned int abs_num = static_cast<unsigned int>(num_to_convert);
+  if(num_to_convert < 0)
+  {
+    abs_num = 0u - abs_num;
+  }
+  do
+  {
+    reversed[reversed_size++] = static_cast<char>('0' + abs_num % 10);
+    abs_num /= 10;
+  }
+  while(abs_num != 0);
+  if(num_to_convert < 0)
+  {
+    reversed[reversed_size++] = '-';
+  }
+
+  std::size_t cur_string_size = string_to_modify.size();
+  string_to_modify.resize(cur_string_size + reversed_size);
+  for(std::size_t cur_char = 0; cur_char < reversed_size; ++cur_char)
+  {
+    string_to_modify[cur_string_size + cur_char] =
+      reversed[reversed_size - 1 - cur_char];
+  }
+}
+
+
+
+template<>
+void to_string_precision<double>(double num_to_convert,
+                                 const std::string &format_string,
+                                 std::string &string_to_modify)
+{
+  std::size_t format_size = format_string.size();
+  char conversion = format_size ? format_string[format_size - 1] : '\0';
+  bool fast_format = format_size >= 4 &&
+                     format_size <= 5 &&
+                     format_string[0] == '%' &&
+                     format_string[1] == '.' &&
+                     (conversion == 'f' || conversion == 'g');
+  int precision = 0;
+  for(std::size_t cur_char = 2;
+      fast_format && cur_char < format_size - 1;
+      ++cur_char)
+  {
+    if(format_string[cur_char] < '0' || format_string[cur_char] > '9')
+    {
+      fast_format = false;
+    }
+    precision = precision * 10 + (format_string[cur_char] - '0');
+  }
+
+  if(!fast_format)
+  {
+    to_string_sprintf<double>(num_to_convert,
+                              format_string,
+                              string_to_modify);
+  }
+  else if(conversion == 'f')
+  {
+    to_string_fixed(num_to_convert, precision, string_to_modify);
+  }
+  else
+  {
+    to_string_general(num_to_convert, precision, string_to_modify);
+  }
+}
+
+
+
+template<>
+void to_string_precision<int>(int num_to_convert,
+                              const std::string &format_string,
+                              std::string &string_to_modify)
+{
+  if(format_string == "%i" || format_string == "%d")
+  {
+    to_string_int(num_to_convert, string_to_modify);
+  }
+  else
+  {
+    to_string_sprintf<int>(num_to_convert, format_string, string_to_modify);
+  }
+}
+
+
+
 } // namespace helpers
 } // namespace tractor_converter
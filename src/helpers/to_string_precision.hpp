@@ -2,6 +2,8 @@
 #define TRACTOR_CONVERTER_to_string_precision_H
 
 #include <cstdlib>
+#include <cstdio>
+#include <cstdint>
 #include <string>
 #include <limits>
 #include <cmath>
@@ -13,10 +15,24 @@ namespace helpers{
 
 
 
+// Appends num_to_convert to string_to_modify.
+// Output is the same as std::sprintf(buf, "%.<precision>f", num_to_convert).
+void to_string_fixed(double num_to_convert,
+                     int precision,
+                     std::string &string_to_modify);
+// Output is the same as std::sprintf(buf, "%.<precision>g", num_to_convert).
+void to_string_general(double num_to_convert,
+                       int precision,
+                       std::string &string_to_modify);
+// Output is the same as std::sprintf(buf, "%i", num_to_convert).
+void to_string_int(int num_to_convert, std::string &string_to_modify);
+
+
+
 template<typename T>
-void to_string_precision(T num_to_convert,
-                         const std::string &format_string,
-                         std::string &string_to_modify)
+void to_string_sprintf(T num_to_convert,
+                       const std::string &format_string,
+                       std::string &string_to_modify)
 {
   std::size_t cur_string_size = string_to_modify.size();
   std::size_t num_to_append =
@@ -30,6 +46,29 @@ void to_string_precision(T num_to_convert,
 
 
 
+template<typename T>
+void to_string_precision(T num_to_convert,
+                         const std::string &format_string,
+                         std::string &string_to_modify)
+{
+  to_string_sprintf<T>(num_to_convert, format_string, string_to_modify);
+}
+
+// "%.<precision>f" and "%.<precision>g" are handled by
+// to_string_fixed and to_string_general.
+// Any other format is passed to std::sprintf.
+template<>
+void to_string_precision<double>(double num_to_convert,
+                                 const std::string &format_string,
+                                 std::string &string_to_modify);
+// "%i" and "%d" are handled by to_string_int.
+template<>
+void to_string_precision<int>(int num_to_convert,
+                              const std::string &format_string,
+                              std::string &string_to_modify);
+
+
+
 } // namespace helpers
 } // namespace tractor_converter
 
@@ -183,11 +183,11 @@ namespace c3d{
     const std::size_t size = coords_size + n_power_size + sort_info_size;
 
     // 0
-    const std::size_t coord_x_rel_pos = vertex::full_coord_size * 0;
+    const std::size_t coord_x_rel_pos = coord_size * 0;
     // 1
-    const std::size_t coord_y_rel_pos = vertex::full_coord_size * 1;
+    const std::size_t coord_y_rel_pos = coord_size * 1;
     // 2
-    const std::size_t coord_z_rel_pos = vertex::full_coord_size * 2;
+    const std::size_t coord_z_rel_pos = coord_size * 2;
 
     // 3
     const std::size_t n_power_rel_pos = coords_size;
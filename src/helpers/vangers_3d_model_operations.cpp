@@ -10,14 +10,14 @@ namespace helpers{
 wheel_data::wheel_data()
 {
   steer = 0;
-  r = std::vector<double>(volInt::axes_num, 0.0);
+  r = volInt::vector_3d_filled(0.0);
   width = 0;
   radius = 0;
 }
 
 weapon_slot_data::weapon_slot_data()
 {
-  R_slot = std::vector<double>(volInt::axes_num, 0.0);
+  R_slot = volInt::vector_3d_filled(0.0);
   location_angle_of_slot = 0.0;
   exists = false;
 }
@@ -162,7 +162,7 @@ void vangers_model::merge_helper_move_model_into_main(
 void vangers_model::merge_model_with_weapon_attachment_point(
   volInt::polyhedron &main_model) const
 {
-  std::vector<double> attachment_point = main_model.offset_point();
+  point attachment_point = main_model.offset_point();
 
   volInt::polyhedron temp_attachment_point_model = *weapon_attachment_point;
   merge_helper_move_model_into_main(
@@ -183,8 +183,8 @@ volInt::model_extreme_points vangers_model::get_wheel_params_extremes()
 
   for(auto wheel_data_el : cur_wheel_data)
   {
-    std::vector<double> wheel_max_point = wheel_data_el.r;
-    std::vector<double> wheel_min_point = wheel_data_el.r;
+    point wheel_max_point = wheel_data_el.r;
+    point wheel_min_point = wheel_data_el.r;
     for(auto cur_axis : volInt::axes_by_plane[VOLINT_X])
     {
       wheel_max_point[cur_axis] += wheel_data_el.radius;
@@ -204,34 +204,34 @@ volInt::model_extreme_points vangers_model::get_wheel_params_extremes()
 
 
 
-std::pair<std::vector<double>, std::vector<double>> &
+std::pair<point, point> &
   vangers_model::extreme_points_pair()
 {
   return extreme_points.extreme_points_pair;
 }
 
-const std::pair<std::vector<double>, std::vector<double>> &
+const std::pair<point, point> &
   vangers_model::extreme_points_pair() const
 {
   return extreme_points.extreme_points_pair;
 }
 
-std::vector<double> &vangers_model::max_point()
+point &vangers_model::max_point()
 {
   return extreme_points.max();
 }
 
-const std::vector<double> &vangers_model::max_point() const
+const point &vangers_model::max_point() const
 {
   return extreme_points.max();
 }
 
-std::vector<double> &vangers_model::min_point()
+point &vangers_model::min_point()
 {
   return extreme_points.min();
 }
 
-const std::vector<double> &vangers_model::min_point() const
+const point &vangers_model::min_point() const
 {
   return extreme_points.min();
 }
@@ -12,7 +12,6 @@
 #include "vangers_cfg_operations.hpp"
 
 #include "volInt.hpp"
-#include "tiny_obj_loader.h"
 
 #include <boost/filesystem.hpp>
 
@@ -42,7 +41,7 @@ enum class normal_flag
 };
 
 typedef long double scaled_float;
-typedef std::vector<double> point;
+typedef volInt::vector_3d point;
 
 
 
@@ -113,6 +112,9 @@ struct vangers_3d_paths_game_dir
   io_paths root;
   io_paths game_lst;
 
+  // Case insensitive lookup of files inside root.input.
+  case_insensitive_path_index root_input_index;
+
   std::unordered_map<std::string, io_paths> mechous_prm;
   std::unordered_map<std::string, io_paths> mechous_m3d;
   std::unordered_map<std::string, io_paths> weapon_m3d;
@@ -127,7 +129,7 @@ struct wheel_data
   wheel_data();
 
   int steer;
-  std::vector<double> r;
+  point r;
   double width;
   double radius;
 
@@ -140,7 +142,7 @@ struct weapon_slot_data
 {
   weapon_slot_data();
 
-  std::vector<double> R_slot;
+  point R_slot;
   double location_angle_of_slot;
 
   bool exists;
@@ -166,7 +168,6 @@ protected:
 
   std::string model_name;
 
-  std::string m3d_data;
   std::size_t m3d_data_cur_pos;
 
   const boost::filesystem::path input_m3d_path;
@@ -250,7 +251,7 @@ protected:
 
   void merge_helper_move_model_into_main(volInt::polyhedron &main_model,
                                          volInt::polyhedron &model_to_move,
-                                         std::vector<double> new_position,
+                                         point new_position,
                                          double new_angle,
                                          int wheel_id,
                                          int weapon_id,
@@ -303,13 +304,13 @@ protected:
 
 
 
-  std::pair<std::vector<double>, std::vector<double>> &extreme_points_pair();
-  const std::pair<std::vector<double>, std::vector<double>> &
+  std::pair<point, point> &extreme_points_pair();
+  const std::pair<point, point> &
     extreme_points_pair() const;
-  std::vector<double> &max_point();
-  const std::vector<double> &max_point() const;
-  std::vector<double> &min_point();
-  const std::vector<double> &min_point() const;
+  point &max_point();
+  const point &max_point() const;
+  point &min_point();
+  const point &min_point() const;
 
   double xmax() const;
   double ymax() const;
@@ -48,84 +48,140 @@ int exception::raw_uncompress_error::zlib_err_code() const noexcept
 
 
 
-std::string raw_uncompress(std::size_t decompressed_size,
-                           std::string &compressed_str)
+raw_inflate_stream::raw_inflate_stream()
 {
-  std::string decompressed_str(decompressed_size, '\0');
-  std::size_t compressed_size = compressed_str.size();
+  m_stream.next_in = Z_NULL;
+  m_stream.avail_in = 0;
+  m_stream.zalloc = static_cast<alloc_func>(Z_NULL);
+  m_stream.zfree = static_cast<free_func>(Z_NULL);
+  m_stream.opaque = static_cast<voidpf>(Z_NULL);
 
-  z_stream stream;
-  int err;
-  const uInt max = static_cast<uInt>(-1);
-  uLong len, left;
-
-  len = compressed_size;
-  if(decompressed_size)
-  {
-    left = decompressed_size;
-  }
-  else
+  // -MAX_WBITS - because of negative value,
+  //              inflate() treats input as raw DEFLATE compression.
+  int err = inflateInit2(&m_stream, -MAX_WBITS);
+  if(err != Z_OK)
   {
-    left = 1;
-    decompressed_str = std::string(1, '\0');
+    throw exception::raw_uncompress_error(m_stream.msg, err);
   }
+}
 
-  stream.next_in = reinterpret_cast<Bytef*>(&compressed_str[0]);
-  stream.avail_in = 0;
-  stream.zalloc = static_cast<alloc_func>(Z_NULL);
-  stream.zfree = static_cast<free_func>(Z_NULL);
-  stream.opaque = static_cast<voidpf>(Z_NULL);
+raw_inflate_stream::~raw_inflate_stream()
+{
+  inflateEnd(&m_stream);
+}
 
-  // -MAX_WBITS - because of negative value,
-  //              inflate() treats input as raw DEFLATE compression.
-  err = inflateInit2(&stream, -MAX_WBITS);
+z_stream &raw_inflate_stream::reset()
+{
+  int err = inflateReset(&m_stream);
   if(err != Z_OK)
   {
-    throw exception::raw_uncompress_error(stream.msg, err);
+    throw exception::raw_uncompress_error(m_stream.msg, err);
   }
+  return m_stream;
+}
+
+
 
-  stream.next_out = reinterpret_cast<Bytef*>(&decompressed_str[0]);
-  stream.avail_out = 0;
+void raw_uncompress(const char *compressed,
+                    std::size_t compressed_size,
+                    std::size_t max_decompressed_size,
+                    std::string &decompressed)
+{
+  thread_local raw_inflate_stream inflate_stream;
+  thread_local std::vector<char> out_chunk(raw_inflate::chunk_size);
+
+  z_stream &stream = inflate_stream.reset();
+  const uInt max = static_cast<uInt>(-1);
+  std::size_t in_left = compressed_size;
+  std::size_t out_left = max_decompressed_size;
 
+  decompressed.reserve(
+    decompressed.size() +
+    std::min(max_decompressed_size,
+             compressed_size * raw_inflate::max_ratio));
+
+  stream.next_in =
+    reinterpret_cast<Bytef*>(const_cast<char*>(compressed));
+  stream.avail_in = 0;
+
+  int err;
   do
   {
-    if(stream.avail_out == 0)
-    {
-      stream.avail_out =
-        left > static_cast<uLong>(max) ? max : static_cast<uInt>(left);
-      left -= stream.avail_out;
-    }
     if(stream.avail_in == 0)
     {
       stream.avail_in =
-        len > static_cast<uLong>(max) ? max : static_cast<uInt>(len);
-      len -= stream.avail_in;
+        in_left > max ? max : static_cast<uInt>(in_left);
+      in_left -= stream.avail_in;
     }
+    stream.next_out = reinterpret_cast<Bytef*>(out_chunk.data());
+    stream.avail_out = static_cast<uInt>(out_chunk.size());
+
     err = inflate(&stream, Z_NO_FLUSH);
+
+    std::size_t out_chunk_size = out_chunk.size() - stream.avail_out;
+    if(out_chunk_size > out_left)
+    {
+      throw exception::raw_uncompress_error(nullptr, Z_BUF_ERROR);
+    }
+    out_left -= out_chunk_size;
+    decompressed.append(out_chunk.data(), out_chunk_size);
   }
   while(err == Z_OK);
 
+  // Z_BUF_ERROR with free room in output means that input is truncated.
+  err = err == Z_STREAM_END ? Z_OK :
+        err == Z_NEED_DICT || err == Z_BUF_ERROR ? Z_DATA_ERROR :
+        err;
 
-
-  if(stream.total_out && err == Z_BUF_ERROR)
+  if(err != Z_OK)
   {
-    left = 1;
+    throw exception::raw_uncompress_error(stream.msg, err);
   }
+}
 
-  inflateEnd(&stream);
 
-  err = err == Z_STREAM_END ? Z_OK :
-        err == Z_NEED_DICT ? Z_DATA_ERROR  :
-        err == Z_BUF_ERROR && left + stream.avail_out ? Z_DATA_ERROR :
-        err;
 
+std::string raw_compress(const std::string &decompressed_str)
+{
+  z_stream stream;
+  stream.zalloc = static_cast<alloc_func>(Z_NULL);
+  stream.zfree = static_cast<free_func>(Z_NULL);
+  stream.opaque = static_cast<voidpf>(Z_NULL);
+
+  // -MAX_WBITS - because of negative value,
+  //              deflate() writes raw DEFLATE compression.
+  int err = deflateInit2(&stream,
+                         Z_BEST_COMPRESSION,
+                         Z_DEFLATED,
+                         -MAX_WBITS,
+                         8,
+                         Z_DEFAULT_STRATEGY);
   if(err != Z_OK)
   {
-    throw exception::raw_uncompress_error(stream.msg, err);
+    throw exception::raw_compress_error(stream.msg, err);
   }
 
-  decompressed_str.resize(stream.total_out);
-  return decompressed_str;
+  std::string compressed_str(
+    deflateBound(&stream, static_cast<uLong>(decompressed_str.size())),
+    '\0');
+
+  stream.next_in =
+    reinterpret_cast<Bytef*>(const_cast<char*>(decompressed_str.data()));
+  stream.avail_in = static_cast<uInt>(decompressed_str.size());
+  stream.next_out = reinterpret_cast<Bytef*>(&compressed_str[0]);
+  stream.avail_out = static_cast<uInt>(compressed_str.size());
+
+  err = deflate(&stream, Z_FINISH);
+  deflateEnd(&stream);
+  if(err != Z_STREAM_END)
+  {
+    throw exception::raw_compress_error(
+      stream.msg,
+      err == Z_OK ? Z_BUF_ERROR : err);
+  }
+
+  compressed_str.resize(stream.total_out);
+  return compressed_str;
 }
 
 
@@ -141,6 +197,152 @@ unsigned int xzip_crypt::crt(unsigned int &val)
 
 
 
+std::uint32_t xzip_crypt::gf2_matrix_apply(const gf2_matrix &matrix,
+                                           std::uint32_t vec)
+{
+  std::uint32_t result = 0;
+  for(std::size_t bit = 0; vec; ++bit, vec >>= 1)
+  {
+    if(vec & 1)
+    {
+      result ^= matrix[bit];
+    }
+  }
+  return result;
+}
+
+xzip_crypt::gf2_matrix xzip_crypt::gf2_matrix_multiply(
+  const gf2_matrix &first,
+  const gf2_matrix &second)
+{
+  gf2_matrix result;
+  for(std::size_t bit = 0; bit < result.size(); ++bit)
+  {
+    result[bit] = gf2_matrix_apply(first, second[bit]);
+  }
+  return result;
+}
+
+xzip_crypt::gf2_matrix xzip_crypt::crt_jump_matrix(std::size_t steps)
+{
+  gf2_matrix step;
+  for(std::size_t bit = 0; bit < step.size(); ++bit)
+  {
+    unsigned int bit_val = 1u << bit;
+    step[bit] = crt(bit_val);
+  }
+
+  gf2_matrix result;
+  for(std::size_t bit = 0; bit < result.size(); ++bit)
+  {
+    result[bit] = static_cast<std::uint32_t>(1) << bit;
+  }
+  for(; steps; steps >>= 1)
+  {
+    if(steps & 1)
+    {
+      result = gf2_matrix_multiply(step, result);
+    }
+    step = gf2_matrix_multiply(step, step);
+  }
+  return result;
+}
+
+void xzip_crypt::apply_keystream(unsigned int key,
+                                 char *data,
+                                 std::size_t size)
+{
+  std::size_t lane_size = size / lanes_num;
+  if(size < min_lanes_data_size)
+  {
+    lane_size = 0;
+  }
+
+  if(lane_size)
+  {
+    unsigned int lanes_state[lanes_num];
+    const gf2_matrix lane_jump = crt_jump_matrix(lane_size);
+    lanes_state[0] = key;
+    for(std::size_t lane = 1; lane < lanes_num; ++lane)
+    {
+      lanes_state[lane] = gf2_matrix_apply(lane_jump, lanes_state[lane - 1]);
+    }
+
+    // Keystream is generated by blocks for all lanes at once
+    // and then applied to data, so generation doesn't have to reload
+    // lane states after each write to data.
+    unsigned int keystream[keystream_block_size][lanes_num];
+    for(std::size_t block_pos = 0;
+        block_pos < lane_size;
+        block_pos += keystream_block_size)
+    {
+      std::size_t block_size =
+        std::min(keystream_block_size, lane_size - block_pos);
+      for(std::size_t cur_pos = 0; cur_pos < block_size; ++cur_pos)
+      {
+        for(std::size_t lane = 0; lane < lanes_num; ++lane)
+        {
+          keystream[cur_pos][lane] = crt(lanes_state[lane]);
+        }
+      }
+      for(std::size_t lane = 0; lane < lanes_num; ++lane)
+      {
+        char *lane_data = data + lane * lane_size + block_pos;
+        for(std::size_t cur_pos = 0; cur_pos < block_size; ++cur_pos)
+        {
+          lane_data[cur_pos] ^= keystream[cur_pos][lane];
+        }
+      }
+    }
+    key = lanes_state[lanes_num - 1];
+  }
+
+  // Remaining bytes continue keystream of the last lane.
+  for(std::size_t cur_pos = lane_size * lanes_num; cur_pos < size; ++cur_pos)
+  {
+    data[cur_pos] ^= crt(key);
+  }
+}
+
+
+
+std::string sicher_cfg_pack(const std::string &plain_str)
+{
+  std::string compressed_str = raw_compress(plain_str);
+
+  std::uint32_t raw_key = static_cast<std::uint32_t>(
+    crc32(0L,
+          reinterpret_cast<const Bytef*>(plain_str.data()),
+          static_cast<uInt>(plain_str.size())));
+
+  std::string packed_str(
+    xzip_crypt::enc_beg_pos + xzip_decompress::comp_beg_pos,
+    '\0');
+  num_to_raw_bytes<std::uint32_t>(raw_key,
+                                  packed_str,
+                                  xzip_crypt::key_pos);
+  num_to_raw_bytes<std::int16_t>(
+    xzip_decompress::deflate_label,
+    packed_str,
+    xzip_crypt::enc_beg_pos + xzip_decompress::label_pos);
+  num_to_raw_bytes<std::uint32_t>(
+    static_cast<std::uint32_t>(plain_str.size()),
+    packed_str,
+    xzip_crypt::enc_beg_pos + xzip_decompress::decomp_size_pos);
+  packed_str.append(compressed_str);
+
+  unsigned int key = raw_key;
+  key *= xzip_crypt::key::multiplier;
+  key |= xzip_crypt::key::bin_or;
+  xzip_crypt::apply_keystream(key,
+                              &packed_str[xzip_crypt::enc_beg_pos],
+                              packed_str.size() - xzip_crypt::enc_beg_pos);
+
+  return packed_str;
+}
+
+
+
 std::string fix_game_lst_path(std::string path)
 {
   boost::algorithm::to_lower(path);
@@ -164,9 +366,17 @@ sicher_cfg_reader::sicher_cfg_reader(
   // If first byte = 0, then file is compressed and encrypted.
   if(!*pos)
   {
+    // Header sizes can't be trusted if file is cut off.
+    if(m_str.size() < xzip_crypt::enc_beg_pos + xzip_decompress::comp_beg_pos)
+    {
+      throw std::runtime_error(
+        input_file_name_error + " file " +
+        input_file_path_str + " is too short to be compressed file.");
+    }
     decrypt();
     decompress();
   }
+  build_keys_index();
 }
 
 
@@ -182,10 +392,7 @@ void sicher_cfg_reader::decrypt()
   m_str.erase(0, xzip_crypt::enc_beg_pos);
   pos = &m_str[0];
 
-  for(char& cur_char : m_str)
-  {
-    cur_char ^= xzip_crypt::crt(key);
-  }
+  xzip_crypt::apply_keystream(key, &m_str[0], m_str.size());
 }
 
 void sicher_cfg_reader::decompress()
@@ -196,15 +403,18 @@ void sicher_cfg_reader::decompress()
     raw_bytes_to_num<std::uint32_t>(m_str, xzip_decompress::decomp_size_pos);
   decompressed_size += xzip_decompress::add_decomp_size;
 
-  m_str.erase(0, xzip_decompress::comp_beg_pos);
-  pos = &m_str[0];
-
   // If label = 0, then file is not compressed.
   if(label)
   {
+    // Inflating straight from m_str
+    // so compressed data is not moved to the beginning first.
+    std::string decompressed_str;
     try
     {
-      m_str = raw_uncompress(decompressed_size, m_str);
+      raw_uncompress(m_str.data() + xzip_decompress::comp_beg_pos,
+                     m_str.size() - xzip_decompress::comp_beg_pos,
+                     decompressed_size,
+                     decompressed_str);
     }
     catch(exception::raw_uncompress_error &e)
     {
@@ -213,9 +423,14 @@ void sicher_cfg_reader::decompress()
         input_file_path_str + " failed to decompress.\n" +
         e.what());
     }
-    pos = &m_str[0];
-    end_pos = &m_str[m_str.size()];
+    m_str = std::move(decompressed_str);
+  }
+  else
+  {
+    m_str.erase(0, xzip_decompress::comp_beg_pos);
   }
+  pos = &m_str[0];
+  end_pos = &m_str[m_str.size()];
 }
 
 
@@ -290,31 +505,79 @@ std::string sicher_cfg_reader::get_cur_pos_value_str<std::string>()
 
 
 
-char *sicher_cfg_reader::get_pos_of_next_value(const std::string &value_name)
+void sicher_cfg_reader::build_keys_index()
 {
-  char *seach_pos = pos;
-  while(true)
+  keys_index.clear();
+
+  const char *str_beg = m_str.c_str();
+  const char *cur_pos = str_beg;
+  // Data after null character is ignored like in C string functions.
+  while(cur_pos < end_pos && *cur_pos)
   {
-    char *value_name_beg = std::strstr(seach_pos, value_name.c_str());
-    if(!value_name_beg)
+    if(std::iswspace(*cur_pos))
     {
-      return nullptr;
+      ++cur_pos;
+      continue;
     }
 
-    char *value_name_end = value_name_beg + value_name.size();
-    if(value_name_end > end_pos)
+    const char *word_beg = cur_pos;
+    for(; cur_pos < end_pos && *cur_pos; ++cur_pos)
     {
-      return nullptr;
+      if(std::iswspace(*cur_pos))
+      {
+        break;
+      }
     }
+    // Key must be followed by whitespace.
+    if(cur_pos < end_pos && *cur_pos)
+    {
+      keys_index[std::string(word_beg, cur_pos)].offsets.push_back(
+        static_cast<std::size_t>(word_beg - str_beg));
+    }
+  }
+}
+
+
 
-    if(std::iswspace(*(value_name_beg - 1)) &&
-       std::iswspace(*(value_name_end)))
+std::size_t sicher_cfg_reader::get_key_offset_ind(key_offsets &key)
+{
+  std::size_t pos_offset = static_cast<std::size_t>(pos - &m_str[0]);
+
+  // Reader is usually moved forward.
+  // Binary search only when pos was moved back.
+  if(key.cursor && key.offsets[key.cursor - 1] >= pos_offset)
+  {
+    key.cursor =
+      std::lower_bound(key.offsets.begin(), key.offsets.end(), pos_offset) -
+      key.offsets.begin();
+  }
+  else
+  {
+    while(key.cursor < key.offsets.size() &&
+          key.offsets[key.cursor] < pos_offset)
     {
-      return value_name_end;
+      ++key.cursor;
     }
+  }
+  return key.cursor;
+}
+
+
 
-    seach_pos = value_name_end;
+char *sicher_cfg_reader::get_pos_of_next_value(const std::string &value_name)
+{
+  auto key = keys_index.find(value_name);
+  if(key == keys_index.end())
+  {
+    return nullptr;
+  }
+
+  std::size_t offset_ind = get_key_offset_ind(key->second);
+  if(offset_ind == key->second.offsets.size())
+  {
+    return nullptr;
   }
+  return &m_str[0] + key->second.offsets[offset_ind] + value_name.size();
 }
 
 
@@ -339,6 +602,32 @@ bool sicher_cfg_reader::check_next_value(const std::string &value_name)
 
 
 
+std::string sicher_cfg_reader::get_nearest_next_key(
+  const std::vector<std::string> &value_names)
+{
+  std::string nearest_key;
+  std::size_t nearest_offset = m_str.size();
+  for(const auto &value_name : value_names)
+  {
+    auto key = keys_index.find(value_name);
+    if(key == keys_index.end())
+    {
+      continue;
+    }
+
+    std::size_t offset_ind = get_key_offset_ind(key->second);
+    if(offset_ind < key->second.offsets.size() &&
+       key->second.offsets[offset_ind] < nearest_offset)
+    {
+      nearest_key = value_name;
+      nearest_offset = key->second.offsets[offset_ind];
+    }
+  }
+  return nearest_key;
+}
+
+
+
 void sicher_cfg_reader::fix_game_lst_paths()
 {
   sicher_cfg_writer game_lst_writer(std::move(m_str),
@@ -346,15 +635,20 @@ void sicher_cfg_reader::fix_game_lst_paths()
                                     input_file_name_error,
                                     m_str.size());
 
-  for(const auto &path_key : van_cfg_key::game_lst::path_vars)
+  // All path keys are fixed in single pass through file.
+  // Writer can't go back so keys are taken in order of their positions.
+  while(true)
   {
-    while(game_lst_writer.check_next_value(path_key))
+    std::string path_key =
+      game_lst_writer.get_nearest_next_key(van_cfg_key::game_lst::path_vars);
+    if(path_key.empty())
     {
-      std::string path =
-        game_lst_writer.get_next_value_keep_pos<std::string>(path_key);
-      std::string fixed_path = fix_game_lst_path(path);
-      game_lst_writer.overwrite_next_value(path_key, fixed_path);
+      break;
     }
+    std::string path =
+      game_lst_writer.get_next_value_keep_pos<std::string>(path_key);
+    std::string fixed_path = fix_game_lst_path(path);
+    game_lst_writer.overwrite_next_value(path_key, fixed_path);
   }
 
   game_lst_writer.write_until_end();
@@ -362,6 +656,7 @@ void sicher_cfg_reader::fix_game_lst_paths()
   m_str = game_lst_writer.extract_out_str();
   pos = &m_str[0];
   end_pos = &m_str[m_str.size()];
+  build_keys_index();
 }
 
 
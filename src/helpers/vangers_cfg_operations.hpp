@@ -13,10 +13,16 @@
 #include <exception>
 #include <stdexcept>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <cwctype>
 #include <cstring>
+#include <map>
 #include <string>
+#include <vector>
 
 
 
@@ -73,12 +79,54 @@ namespace exception{
     std::string m_zlib_string;
     int m_zlib_err_code;
   };
+
+  class raw_compress_error : public raw_uncompress_error
+  {
+    public:
+    using raw_uncompress_error::raw_uncompress_error;
+  };
 } // namespace exception
 
 
 
-std::string raw_uncompress(std::size_t decompressed_size,
-                           const std::string &compressed);
+namespace raw_inflate{
+  // Size of chunks in which inflated data is appended to output.
+  const std::size_t chunk_size = 64 * 1024;
+  // DEFLATE can't compress data more than that,
+  // so bigger expected sizes are not trusted when reserving memory.
+  const std::size_t max_ratio = 1032;
+} // namespace raw_inflate
+
+// z_stream initialized once and reset for each decompression,
+// so zlib state and window are not allocated for each file.
+class raw_inflate_stream
+{
+
+public:
+
+  raw_inflate_stream();
+  ~raw_inflate_stream();
+  raw_inflate_stream(const raw_inflate_stream&) = delete;
+  raw_inflate_stream &operator=(const raw_inflate_stream&) = delete;
+
+  z_stream &reset();
+
+private:
+
+  z_stream m_stream;
+
+};
+
+// Raw DEFLATE decompression without zlib header.
+// Decompressed data is appended to decompressed chunk by chunk.
+// Throws as soon as decompressed data exceeds max_decompressed_size.
+// Uses zlib stream and chunk buffer local to calling thread.
+void raw_uncompress(const char *compressed,
+                    std::size_t compressed_size,
+                    std::size_t max_decompressed_size,
+                    std::string &decompressed);
+// Raw DEFLATE compression without zlib header.
+std::string raw_compress(const std::string &decompressed);
 
 
 
@@ -92,6 +140,31 @@ namespace xzip_crypt{
   } // namespace key
 
   unsigned int crt(unsigned int &val);
+
+  // Keystream generator of crt() is linear over GF(2),
+  // so state after any number of steps can be calculated
+  // by multiplying initial state by power of step matrix.
+  // Each column of matrix is image of single bit of state.
+  typedef std::array<std::uint32_t, 32> gf2_matrix;
+
+  std::uint32_t gf2_matrix_apply(const gf2_matrix &matrix, std::uint32_t vec);
+  gf2_matrix gf2_matrix_multiply(const gf2_matrix &first,
+                                 const gf2_matrix &second);
+  // Matrix to make steps number of crt() steps at once.
+  gf2_matrix crt_jump_matrix(std::size_t steps);
+
+  // Data shorter than that is processed without splitting into lanes.
+  const std::size_t min_lanes_data_size = 256;
+  const std::size_t lanes_num = 8;
+  const std::size_t keystream_block_size = 64;
+
+  // XORs data with keystream generated by crt() from key.
+  // Data is split into lanes_num equal parts,
+  // start state of each part is calculated with jump matrix
+  // and parts are processed together so their steps don't wait
+  // for each other.
+  // Result is the same as of serial loop over data with crt().
+  void apply_keystream(unsigned int key, char *data, std::size_t size);
 } // namespace xzip_crypt
 
 
@@ -102,10 +175,21 @@ namespace xzip_decompress {
   const std::size_t comp_beg_pos = decomp_size_pos + sizeof(std::uint32_t);
 
   const std::size_t add_decomp_size = 12;
+
+  // Any non-zero label means that data is compressed.
+  const std::int16_t deflate_label = 83;
 } // namespace xzip_decompress
 
 
 
+// Compresses and encrypts *.prm or *.lst file data
+// the same way as files shipped with the game.
+// Key is derived from data so output is the same for the same data.
+// Result can be read by sicher_cfg_reader.
+std::string sicher_cfg_pack(const std::string &plain_str);
+
+
+
 namespace sicher_cfg_format{
   const std::string sprintf_int = "%i";
   const int sprintf_float_precision = 6;
@@ -146,6 +230,9 @@ public:
   }
 
   bool check_next_value(const std::string &value_name);
+  // Returns whichever of value_names is found first after pos.
+  // Returns empty string if none of them is found.
+  std::string get_nearest_next_key(const std::vector<std::string> &value_names);
 
   void fix_game_lst_paths();
 
@@ -160,6 +247,23 @@ protected:
   std::string input_file_path_str;
   std::string input_file_name_error;
 
+  // Offsets of whitespace delimited words in m_str
+  // so keys are not searched by scanning m_str each time.
+  // cursor is index of first offset which was not passed yet,
+  // so going through repeated key costs nothing more than one step.
+  struct key_offsets
+  {
+    std::vector<std::size_t> offsets;
+    std::size_t cursor = 0;
+  };
+  std::map<std::string, key_offsets> keys_index;
+
+  // Must be called each time m_str is changed.
+  void build_keys_index();
+  // Index of first offset of key which is not before pos.
+  // Returns offsets.size() if there is no such offset.
+  std::size_t get_key_offset_ind(key_offsets &key);
+
   char *get_pos_of_next_value(const std::string &value_name);
   // Set pos pointer right after value_name string found in m_str.
   void move_pos_to_value(const std::string &value_name);
@@ -0,0 +1,520 @@
+#include "volInt_cache_operations.hpp"
+
+
+
+namespace tractor_converter{
+namespace helpers{
+
+
+
+boost::filesystem::path volInt_cache_path(
+  const boost::filesystem::path &obj_path_arg)
+{
+  boost::filesystem::path cache_path = obj_path_arg;
+  cache_path += ext::volInt_cache;
+  return cache_path;
+}
+
+
+
+std::uint64_t volInt_cache_obj_hash(const char *data, std::size_t size)
+{
+  const std::uint64_t fnv_offset_basis = 14695981039346656037ULL;
+  const std::uint64_t fnv_prime = 1099511628211ULL;
+
+  std::uint64_t hash = fnv_offset_basis;
+  const char *cur_byte = data;
+  for(const char *words_end = data + size / sizeof(std::uint64_t) *
+                                sizeof(std::uint64_t);
+      cur_byte < words_end;
+      cur_byte += sizeof(std::uint64_t))
+  {
+    std::uint64_t word;
+    std::memcpy(&word, cur_byte, sizeof(std::uint64_t));
+    hash ^= word;
+    hash *= fnv_prime;
+  }
+  for(const char *end = data + size; cur_byte < end; ++cur_byte)
+  {
+    hash ^= static_cast<unsigned char>(*cur_byte);
+    hash *= fnv_prime;
+  }
+  return hash;
+}
+
+
+
+std::size_t volInt_cache_size(std::size_t verts_num,
+                              std::size_t vert_norms_num,
+                              std::size_t faces_num,
+                              std::size_t verts_per_poly,
+                              std::size_t wheel_els_num)
+{
+  std::size_t face_size =
+    sizeof(std::uint32_t) +
+    2 * sizeof(std::int32_t) +
+    volInt::axes_num * sizeof(double) +
+    sizeof(double) +
+    2 * verts_per_poly * sizeof(std::int32_t);
+
+  return volInt_cache::header_size +
+         verts_num * volInt::axes_num * sizeof(double) +
+         vert_norms_num * volInt::axes_num * sizeof(double) +
+         faces_num * face_size +
+         wheel_els_num * sizeof(std::uint64_t);
+}
+
+std::size_t volInt_cache_size(const volInt::polyhedron &volInt_model)
+{
+  return volInt_cache_size(volInt_model.verts.size(),
+                           volInt_model.vertNorms.size(),
+                           volInt_model.faces.size(),
+                           volInt_model.numVertsPerPoly,
+                           volInt_model.wheels.size() +
+                             volInt_model.wheels_steer.size() +
+                             volInt_model.wheels_non_steer.size() +
+                             volInt_model.wheels_ghost.size() +
+                             volInt_model.wheels_non_ghost.size());
+}
+
+
+
+bool load_volInt_cache(
+  const boost::filesystem::path &obj_path_arg,
+  const std::string &obj_file_name_error,
+  int expected_verts_per_poly,
+  volInt::polyhedron &volInt_model)
+{
+  boost::filesystem::path cache_path = volInt_cache_path(obj_path_arg);
+  if(!boost::filesystem::is_regular_file(cache_path))
+  {
+    return false;
+  }
+
+  std::uint64_t obj_size = boost::filesystem::file_size(obj_path_arg);
+  std::int64_t obj_time = boost::filesystem::last_write_time(obj_path_arg);
+
+  file_view cache(cache_path, obj_file_name_error);
+  const char *bytes = cache.data();
+  std::size_t cache_size = cache.size();
+
+  if(cache_size < volInt_cache::header_size ||
+     cache.substr(0, volInt_cache::signature.size()) !=
+       volInt_cache::signature)
+  {
+    return false;
+  }
+  std::size_t pos = volInt_cache::signature.size();
+
+  if(volInt_cache_read_num<std::uint32_t>(bytes, pos) !=
+       volInt_cache::version ||
+     volInt_cache_read_num<std::uint64_t>(bytes, pos) != obj_size ||
+     volInt_cache_read_num<std::int64_t>(bytes, pos) != obj_time)
+  {
+    return false;
+  }
+  {
+    file_view obj(obj_path_arg, obj_file_name_error);
+    if(volInt_cache_read_num<std::uint64_t>(bytes, pos) !=
+       volInt_cache_obj_hash(obj.data(), obj.size()))
+    {
+      return false;
+    }
+  }
+
+  int num_verts = volInt_cache_read_num<std::int32_t>(bytes, pos);
+  int num_vert_norms = volInt_cache_read_num<std::int32_t>(bytes, pos);
+  int num_faces = volInt_cache_read_num<std::int32_t>(bytes, pos);
+  int verts_per_poly = volInt_cache_read_num<std::int32_t>(bytes, pos);
+  if(num_verts < 0 ||
+     num_vert_norms < 0 ||
+     num_faces < 0 ||
+     verts_per_poly != expected_verts_per_poly)
+  {
+    return false;
+  }
+
+  int body_color_offset = volInt_cache_read_num<std::int32_t>(bytes, pos);
+  int body_color_shift = volInt_cache_read_num<std::int32_t>(bytes, pos);
+
+  // Wheel sets sizes are stored after the rest of header.
+  std::size_t wheel_sets_sizes_pos =
+    volInt_cache::header_size -
+    volInt_cache::wheel_sets_num * sizeof(std::uint64_t);
+  std::uint64_t wheel_sets_sizes[volInt_cache::wheel_sets_num];
+  std::uint64_t wheel_els_num = 0;
+  for(auto &&wheel_set_size : wheel_sets_sizes)
+  {
+    wheel_set_size =
+      volInt_cache_read_num<std::uint64_t>(bytes, wheel_sets_sizes_pos);
+    // Prevents overflow while calculating expected size.
+    if(wheel_set_size > cache_size)
+    {
+      return false;
+    }
+    wheel_els_num += wheel_set_size;
+  }
+
+  if(volInt_cache_size(num_verts,
+                       num_vert_norms,
+                       num_faces,
+                       verts_per_poly,
+                       wheel_els_num) != cache_size)
+  {
+    return false;
+  }
+
+
+
+  volInt::polyhedron loaded_model(num_verts,
+                                  num_vert_norms,
+                                  num_faces,
+                                  verts_per_poly);
+  loaded_model.bodyColorOffset = body_color_offset;
+  loaded_model.bodyColorShift = body_color_shift;
+
+  loaded_model.volume_overwritten =
+    volInt_cache_read_num<std::uint8_t>(bytes, pos);
+  loaded_model.rcm_overwritten =
+    volInt_cache_read_num<std::uint8_t>(bytes, pos);
+  loaded_model.J_overwritten =
+    volInt_cache_read_num<std::uint8_t>(bytes, pos);
+
+  loaded_model.volume = volInt_cache_read_num<double>(bytes, pos);
+  for(auto &&coord : loaded_model.rcm)
+  {
+    coord = volInt_cache_read_num<double>(bytes, pos);
+  }
+  for(auto &&row : loaded_model.J)
+  {
+    for(auto &&el : row)
+    {
+      el = volInt_cache_read_num<double>(bytes, pos);
+    }
+  }
+  pos = volInt_cache::header_size;
+
+
+
+  for(auto &&vert : loaded_model.verts)
+  {
+    for(auto &&coord : vert)
+    {
+      coord = volInt_cache_read_num<double>(bytes, pos);
+    }
+  }
+  for(auto &&vert_norm : loaded_model.vertNorms)
+  {
+    for(auto &&coord : vert_norm)
+    {
+      coord = volInt_cache_read_num<double>(bytes, pos);
+    }
+  }
+
+  for(auto &&cur_face : loaded_model.faces)
+  {
+    cur_face.color_id = volInt_cache_read_num<std::uint32_t>(bytes, pos);
+    cur_face.wheel_id = volInt_cache_read_num<std::int32_t>(bytes, pos);
+    cur_face.weapon_id = volInt_cache_read_num<std::int32_t>(bytes, pos);
+    for(auto &&coord : cur_face.norm)
+    {
+      coord = volInt_cache_read_num<double>(bytes, pos);
+    }
+    cur_face.w = volInt_cache_read_num<double>(bytes, pos);
+    for(auto &&vert_ind : cur_face.verts)
+    {
+      vert_ind = volInt_cache_read_num<std::int32_t>(bytes, pos);
+      if(vert_ind < 0 || vert_ind >= num_verts)
+      {
+        return false;
+      }
+    }
+    for(auto &&vert_norm_ind : cur_face.vertNorms)
+    {
+      vert_norm_ind = volInt_cache_read_num<std::int32_t>(bytes, pos);
+      if(vert_norm_ind >= num_vert_norms)
+      {
+        return false;
+      }
+    }
+  }
+
+  std::unordered_set<std::size_t> *wheel_sets[volInt_cache::wheel_sets_num] =
+  {
+    &loaded_model.wheels,
+    &loaded_model.wheels_steer,
+    &loaded_model.wheels_non_steer,
+    &loaded_model.wheels_ghost,
+    &loaded_model.wheels_non_ghost,
+  };
+  for(std::size_t cur_set = 0; cur_set < volInt_cache::wheel_sets_num;
+      ++cur_set)
+  {
+    wheel_sets[cur_set]->reserve(wheel_sets_sizes[cur_set]);
+    for(std::uint64_t cur_el = 0; cur_el < wheel_sets_sizes[cur_set];
+        ++cur_el)
+    {
+      wheel_sets[cur_set]->insert(
+        volInt_cache_read_num<std::uint64_t>(bytes, pos));
+    }
+  }
+
+  volInt_model = std::move(loaded_model);
+  return true;
+}
+
+
+
+void save_volInt_cache(
+  const boost::filesystem::path &obj_path_arg,
+  const std::string &obj_file_name_error,
+  const volInt::polyhedron &volInt_model)
+{
+  std::uint64_t obj_size = boost::filesystem::file_size(obj_path_arg);
+  std::int64_t obj_time = boost::filesystem::last_write_time(obj_path_arg);
+  std::uint64_t obj_hash;
+  {
+    file_view obj(obj_path_arg, obj_file_name_error);
+    obj_hash = volInt_cache_obj_hash(obj.data(), obj.size());
+  }
+
+  file_output_view cache(volInt_cache_path(obj_path_arg),
+                         volInt_cache_size(volInt_model),
+                         obj_file_name_error);
+  char *bytes = cache.data();
+  std::size_t pos = 0;
+
+  std::copy(volInt_cache::signature.begin(),
+            volInt_cache::signature.end(),
+            bytes);
+  pos += volInt_cache::signature.size();
+
+  volInt_cache_write_num<std::uint32_t>(volInt_cache::version, bytes, pos);
+  volInt_cache_write_num<std::uint64_t>(obj_size, bytes, pos);
+  volInt_cache_write_num<std::int64_t>(obj_time, bytes, pos);
+  volInt_cache_write_num<std::uint64_t>(obj_hash, bytes, pos);
+
+  volInt_cache_write_num<std::int32_t>(
+    volInt_model.verts.size(), bytes, pos);
+  volInt_cache_write_num<std::int32_t>(
+    volInt_model.vertNorms.size(), bytes, pos);
+  volInt_cache_write_num<std::int32_t>(
+    volInt_model.faces.size(), bytes, pos);
+  volInt_cache_write_num<std::int32_t>(
+    volInt_model.numVertsPerPoly, bytes, pos);
+
+  volInt_cache_write_num<std::int32_t>(
+    volInt_model.bodyColorOffset, bytes, pos);
+  volInt_cache_write_num<std::int32_t>(
+    volInt_model.bodyColorShift, bytes, pos);
+
+  volInt_cache_write_num<std::uint8_t>(
+    volInt_model.volume_overwritten, bytes, pos);
+  volInt_cache_write_num<std::uint8_t>(
+    volInt_model.rcm_overwritten, bytes, pos);
+  volInt_cache_write_num<std::uint8_t>(
+    volInt_model.J_overwritten, bytes, pos);
+
+  volInt_cache_write_num<double>(volInt_model.volume, bytes, pos);
+  for(const auto coord : volInt_model.rcm)
+  {
+    volInt_cache_write_num<double>(coord, bytes, pos);
+  }
+  for(const auto &row : volInt_model.J)
+  {
+    for(const auto el : row)
+    {
+      volInt_cache_write_num<double>(el, bytes, pos);
+    }
+  }
+
+  const std::unordered_set<std::size_t>
+    *wheel_sets[volInt_cache::wheel_sets_num] =
+  {
+    &volInt_model.wheels,
+    &volInt_model.wheels_steer,
+    &volInt_model.wheels_non_steer,
+    &volInt_model.wheels_ghost,
+    &volInt_model.wheels_non_ghost,
+  };
+  for(const auto wheel_set : wheel_sets)
+  {
+    volInt_cache_write_num<std::uint64_t>(wheel_set->size(), bytes, pos);
+  }
+
+
+
+  for(const auto &vert : volInt_model.verts)
+  {
+    for(const auto coord : vert)
+    {
+      volInt_cache_write_num<double>(coord, bytes, pos);
+    }
+  }
+  for(const auto &vert_norm : volInt_model.vertNorms)
+  {
+    for(const auto coord : vert_norm)
+    {
+      volInt_cache_write_num<double>(coord, bytes, pos);
+    }
+  }
+
+  for(const auto &cur_face : volInt_model.faces)
+  {
+    volInt_cache_write_num<std::uint32_t>(cur_face.color_id, bytes, pos);
+    volInt_cache_write_num<std::int32_t>(cur_face.wheel_id, bytes, pos);
+    volInt_cache_write_num<std::int32_t>(cur_face.weapon_id, bytes, pos);
+    for(const auto coord : cur_face.norm)
+    {
+      volInt_cache_write_num<double>(coord, bytes, pos);
+    }
+    volInt_cache_write_num<double>(cur_face.w, bytes, pos);
+    for(const auto vert_ind : cur_face.verts)
+    {
+      volInt_cache_write_num<std::int32_t>(vert_ind, bytes, pos);
+    }
+    for(const auto vert_norm_ind : cur_face.vertNorms)
+    {
+      volInt_cache_write_num<std::int32_t>(vert_norm_ind, bytes, pos);
+    }
+  }
+
+  // Sorted so the same model always produces the same cache.
+  for(const auto wheel_set : wheel_sets)
+  {
+    std::vector<std::size_t> sorted_set(wheel_set->begin(),
+                                        wheel_set->end());
+    std::sort(sorted_set.begin(), sorted_set.end());
+    for(const auto el : sorted_set)
+    {
+      volInt_cache_write_num<std::uint64_t>(el, bytes, pos);
+    }
+  }
+
+  cache.commit();
+}
+
+
+
+void volInt_cache_apply_default_color(
+  const boost::filesystem::path &obj_path_arg,
+  const std::string &obj_file_name_error,
+  unsigned int default_color_id,
+  volInt::polyhedron &volInt_model)
+{
+  for(std::size_t face_ind = 0, faces_size = volInt_model.faces.size();
+      face_ind < faces_size;
+      ++face_ind)
+  {
+    volInt::face &cur_face = volInt_model.faces[face_ind];
+    if(cur_face.color_id != volInt_cache::default_color_placeholder)
+    {
+      continue;
+    }
+    cur_face.color_id = default_color_id;
+
+    // Same check as in raw_obj_to_volInt_model().
+    if(default_color_id < c3d::color::string_to_id::max_colors_ids)
+    {
+      for(std::size_t cur_poly_vert_num = 0;
+          cur_poly_vert_num < cur_face.vertNorms.size();
+          ++cur_poly_vert_num)
+      {
+        if(cur_face.vertNorms[cur_poly_vert_num] < 0)
+        {
+          throw std::runtime_error(
+            "In " + obj_file_name_error + " file " +
+            obj_path_arg.string() +
+            " face " + std::to_string(face_ind) +
+            " has no normal index specified for vertex " +
+            std::to_string(cur_poly_vert_num) + "." + '\n' +
+            "All faces which are part of actual model" +
+            " must have specified normal indices.");
+        }
+      }
+    }
+  }
+}
+
+
+
+volInt::polyhedron raw_obj_to_volInt_model_cached(
+  const boost::filesystem::path &input_file_path_arg,
+  const std::string &input_file_name_error,
+  c3d::c3d_type type,
+  unsigned int default_color_id,
+  bool use_cache_arg,
+  std::size_t jobs_num)
+{
+  // Missing *.obj file is reported by raw_obj_to_volInt_model().
+  if(!use_cache_arg ||
+     !boost::filesystem::is_regular_file(input_file_path_arg))
+  {
+    return raw_obj_to_volInt_model(input_file_path_arg,
+                                   input_file_name_error,
+                                   type,
+                                   default_color_id,
+                                   jobs_num);
+  }
+
+  int expected_verts_per_poly = c3d::regular_model_vertices_per_polygon;
+  if(type == c3d::c3d_type::bound)
+  {
+    expected_verts_per_poly = c3d::bound_model_vertices_per_polygon;
+  }
+
+  volInt::polyhedron volInt_model;
+  bool cache_loaded = false;
+  try
+  {
+    cache_loaded = load_volInt_cache(input_file_path_arg,
+                                     input_file_name_error,
+                                     expected_verts_per_poly,
+                                     volInt_model);
+  }
+  catch(std::exception &)
+  {
+    cache_loaded = false;
+  }
+
+  if(cache_loaded)
+  {
+    volInt_model.wavefront_obj_path = input_file_path_arg.string();
+    if(type == c3d::c3d_type::main_of_mechos)
+    {
+      raw_obj_to_volInt_helper_check_wheels(input_file_path_arg,
+                                            input_file_name_error,
+                                            volInt_model);
+    }
+  }
+  else
+  {
+    volInt_model =
+      raw_obj_to_volInt_model(input_file_path_arg,
+                              input_file_name_error,
+                              type,
+                              volInt_cache::default_color_placeholder,
+                              jobs_num);
+    try
+    {
+      save_volInt_cache(input_file_path_arg,
+                        input_file_name_error,
+                        volInt_model);
+    }
+    catch(std::exception &)
+    {
+      // Cache is optional so model is still used if it can't be saved.
+    }
+  }
+
+  volInt_cache_apply_default_color(input_file_path_arg,
+                                   input_file_name_error,
+                                   default_color_id,
+                                   volInt_model);
+  return volInt_model;
+}
+
+
+
+} // namespace helpers
+} // namespace tractor_converter
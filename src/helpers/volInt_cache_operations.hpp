@@ -0,0 +1,154 @@
+#ifndef TRACTOR_CONVERTER_VOLINT_CACHE_OPERATIONS_H
+#define TRACTOR_CONVERTER_VOLINT_CACHE_OPERATIONS_H
+
+#include "defines.hpp"
+#include "vangers_3d_model_constants.hpp"
+
+#include "raw_num_operations.hpp"
+#include "file_operations.hpp"
+#include "wavefront_obj_operations.hpp"
+
+#include "volInt.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <exception>
+#include <stdexcept>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <unordered_set>
+
+
+
+namespace tractor_converter{
+namespace helpers{
+
+
+
+// Binary cache of volInt::polyhedron parsed from *.obj file.
+// It's saved next to *.obj file as "<name>.obj.vcache".
+// Cache is used instead of parsing *.obj file while size,
+// modification time and content hash of *.obj file are the same
+// as when cache was saved.
+// Modification time has 1 second resolution on some file systems,
+// so content hash catches files changed right after cache was saved.
+// Hash is calculated over the whole *.obj file each time cache is checked.
+// It's taken by 8 byte words, so it costs about as much as reading the file
+// and much less than parsing it.
+//
+// Layout, all numbers are in native byte order:
+// signature, version, *.obj size, *.obj modification time, *.obj hash,
+// numVerts, numVertNorms, numFaces, numVertsPerPoly,
+// bodyColorOffset, bodyColorShift,
+// volume_overwritten, rcm_overwritten, J_overwritten, volume, rcm, J,
+// sizes of wheels, wheels_steer, wheels_non_steer, wheels_ghost and
+// wheels_non_ghost sets,
+// verts, vertNorms,
+// faces (color_id, wheel_id, weapon_id, norm, w, verts, vertNorms),
+// elements of wheel sets in the same order as their sizes.
+namespace volInt_cache{
+  const std::string signature = "TCVOLINT";
+  const std::uint32_t version = 3;
+
+  // Color ID of faces which have no material or unexpected one.
+  // Cached model is parsed with it so cache doesn't depend
+  // on default color ID. It's replaced with actual default color ID
+  // after model is parsed or loaded from cache.
+  const unsigned int default_color_placeholder =
+    c3d::color::string_to_id::virtual_object_ids_end + 1;
+
+  const std::size_t wheel_sets_num = 5;
+
+  const std::size_t header_size =
+    signature.size() +
+    sizeof(std::uint32_t) +
+    sizeof(std::uint64_t) +
+    sizeof(std::int64_t) +
+    sizeof(std::uint64_t) +
+    4 * sizeof(std::int32_t) +
+    2 * sizeof(std::int32_t) +
+    3 * sizeof(std::uint8_t) +
+    sizeof(double) +
+    volInt::axes_num * sizeof(double) +
+    volInt::axes_num * volInt::axes_num * sizeof(double) +
+    wheel_sets_num * sizeof(std::uint64_t);
+} // namespace volInt_cache
+
+
+
+template<typename T>
+void volInt_cache_write_num(const T num, char *bytes, std::size_t &pos)
+{
+  num_to_raw_bytes<T>(num, bytes, pos);
+  pos += sizeof(T);
+}
+
+template<typename T>
+T volInt_cache_read_num(const char *bytes, std::size_t &pos)
+{
+  T num = raw_bytes_to_num<T>(bytes, pos);
+  pos += sizeof(T);
+  return num;
+}
+
+
+
+boost::filesystem::path volInt_cache_path(
+  const boost::filesystem::path &obj_path_arg);
+
+// 64-bit FNV-1a hash of *.obj file content.
+// Content is taken by 8 byte words in native byte order
+// and then by remaining bytes.
+std::uint64_t volInt_cache_obj_hash(const char *data, std::size_t size);
+
+std::size_t volInt_cache_size(std::size_t verts_num,
+                              std::size_t vert_norms_num,
+                              std::size_t faces_num,
+                              std::size_t verts_per_poly,
+                              std::size_t wheel_els_num);
+std::size_t volInt_cache_size(const volInt::polyhedron &volInt_model);
+
+// Returns false if cache doesn't exist, is outdated or malformed.
+bool load_volInt_cache(
+  const boost::filesystem::path &obj_path_arg,
+  const std::string &obj_file_name_error,
+  int expected_verts_per_poly,
+  volInt::polyhedron &volInt_model);
+
+void save_volInt_cache(
+  const boost::filesystem::path &obj_path_arg,
+  const std::string &obj_file_name_error,
+  const volInt::polyhedron &volInt_model);
+
+// Replaces volInt_cache::default_color_placeholder with default_color_id.
+// Throws if such polygon must be saved in *.m3d/*.a3d model
+// but has no normal indices.
+void volInt_cache_apply_default_color(
+  const boost::filesystem::path &obj_path_arg,
+  const std::string &obj_file_name_error,
+  unsigned int default_color_id,
+  volInt::polyhedron &volInt_model);
+
+// Same as raw_obj_to_volInt_model() if use_cache_arg is false.
+// Otherwise cache of *.obj file is used when it's up to date.
+// Missing or outdated cache is saved again after parsing *.obj file.
+volInt::polyhedron raw_obj_to_volInt_model_cached(
+  const boost::filesystem::path &input_file_path_arg,
+  const std::string &input_file_name_error,
+  c3d::c3d_type type,
+  unsigned int default_color_id,
+  bool use_cache_arg,
+  std::size_t jobs_num);
+
+
+
+} // namespace helpers
+} // namespace tractor_converter
+
+#endif // TRACTOR_CONVERTER_VOLINT_CACHE_OPERATIONS_H
@@ -310,120 +310,87 @@ void raw_obj_to_volInt_helper_get_weapon_num(
 
 
 
-volInt::polyhedron raw_obj_to_volInt_model(
+void raw_obj_to_volInt_helper_check_wheels(
   const boost::filesystem::path &input_file_path_arg,
   const std::string &input_file_name_error,
-  c3d::c3d_type type,
-  unsigned int default_color_id)
+  const volInt::polyhedron &volInt_model)
 {
-  std::string obj_data =
-    read_file(input_file_path_arg,
-              file_flag::read_all,
-              0,
-              0,
-              read_all_dummy_size,
-              input_file_name_error);
-
-
-  // Reading *.obj file with tiny_obj_loader.
-
-  unsigned char expected_n_verts_per_poly;
-  std::string expected_n_verts_per_poly_err_str;
-  if(type == c3d::c3d_type::regular ||
-     type == c3d::c3d_type::main_of_mechos)
-  {
-    expected_n_verts_per_poly = c3d::regular_model_vertices_per_polygon;
-    expected_n_verts_per_poly_err_str = "regular";
-  }
-  if(type == c3d::c3d_type::bound)
-  {
-    expected_n_verts_per_poly = c3d::bound_model_vertices_per_polygon;
-    expected_n_verts_per_poly_err_str = "bound";
-  }
-
-  std::stringstream objStream(obj_data);
-
-  tinyobj::attrib_t attrib;
-  std::vector<tinyobj::shape_t> shapes;
-  std::vector<tinyobj::material_t> materials;
-  std::string err;
-  bool ret = tinyobj::LoadObj(&attrib,
-                              &shapes,
-                              &materials,
-                              &err,
-                              &objStream,
-                              nullptr,
-                              false,
-                              false);
-
-  if(!err.empty())
-  {
-    throw std::runtime_error(
-      "Error while loading " + input_file_name_error +
-      " file " + input_file_path_arg.string() +
-      " as " + ext::readable::wavefront_obj + ". "
-      "tiny_obj_loader error: " + err);
+  // Checking wheels.
+  int n_wheels = volInt_model.wheels.size();
+  std::vector<int> missed_wheels;
+  std::vector<int> out_of_range_wheels;
+  missed_wheels.reserve(n_wheels);
+  out_of_range_wheels.reserve(n_wheels);
+  for(std::size_t cur_wheel = 0; cur_wheel < n_wheels; ++cur_wheel)
+  {
+    if(!volInt_model.wheels.count(cur_wheel))
+    {
+      missed_wheels.push_back(cur_wheel);
+    }
   }
-
-  if(!ret)
+  for(std::size_t cur_wheel : volInt_model.wheels)
   {
-    throw std::runtime_error(
-      "Error while loading " + input_file_name_error +
-      " file " + input_file_path_arg.string() +
-      " as " + ext::readable::wavefront_obj + ". "
-      "tinyobj::LoadObj returned false.");
+    if(cur_wheel >= n_wheels)
+    {
+      out_of_range_wheels.push_back(cur_wheel);
+    }
   }
 
-
-
-
-
-  // Getting sizes and checking whether retrieved info is correct.
-
-  // attrib.vertices and attrib.norms are std::vector<double>.
-  // Each 3 double numbers = 1 vertex.
-  std::size_t num_verts = attrib.vertices.size() / volInt::axes_num;
-  std::size_t num_vert_norms = attrib.normals.size() / volInt::axes_num;
-
-  int num_faces = 0;
-  for(const auto &shape : shapes)
+  if(missed_wheels.size() || out_of_range_wheels.size())
   {
-    num_faces += shape.mesh.num_face_vertices.size();
-  }
-
-
+    std::string missed_wheels_str;
+    std::string out_of_range_wheels_str;
 
-  for(const auto &shape : shapes)
-  {
-    for(const auto &num_face_vertex : shape.mesh.num_face_vertices)
+    if(missed_wheels.size() == 1)
     {
-      if(expected_n_verts_per_poly != num_face_vertex)
-      {
-        throw std::runtime_error(
-          "Error while loading " + input_file_name_error +
-          " file " + input_file_path_arg.string() +
-          " as " + ext::readable::wavefront_obj + ". Expected " +
-          expected_n_verts_per_poly_err_str +
-          " object with " +
-          std::to_string(
-            static_cast<unsigned short int>(expected_n_verts_per_poly)) +
-          " vertices per polygon. Found polygon with " +
-          std::to_string(static_cast<unsigned short int>(num_face_vertex)) +
-          " vertices.");
-      }
+      missed_wheels_str.append("Missed wheel:\n");
+    }
+    else
+    {
+      missed_wheels_str.append("Missed wheels:\n");
+    }
+    for(std::size_t missed_wheel : missed_wheels)
+    {
+      missed_wheels_str.append(std::to_string(missed_wheel + 1) + "\n");
     }
-  }
-
 
+    if(out_of_range_wheels.size() == 1)
+    {
+      missed_wheels_str.append("Out of range wheel:" "\n");
+    }
+    else
+    {
+      missed_wheels_str.append("Out of range wheels:" "\n");
+    }
+    for(std::size_t out_of_range_wheel : out_of_range_wheels)
+    {
+      out_of_range_wheels_str.append(
+        std::to_string(out_of_range_wheel + 1) + "\n");
+    }
 
+    throw std::runtime_error(
+      "In " + input_file_name_error + " file " +
+      input_file_path_arg.string() +
+      " wheels order is wrong. " + '\n' +
+      "It is assumed that all wheels are numbered " +
+      "from 1 to number of wheels." + '\n' +
+      missed_wheels_str +
+      out_of_range_wheels_str +
+      '\n');
+  }
+}
 
 
-  volInt::polyhedron volInt_model(num_verts,
-                                  num_vert_norms,
-                                  num_faces,
-                                  expected_n_verts_per_poly);
-  volInt_model.wavefront_obj_path = input_file_path_arg.string();
 
+void raw_obj_to_volInt_helper_assign_materials(
+  const boost::filesystem::path &input_file_path_arg,
+  const std::string &input_file_name_error,
+  c3d::c3d_type type,
+  unsigned int default_color_id,
+  const std::vector<std::string> &materials,
+  const std::vector<int> &face_material_ids,
+  volInt::polyhedron &volInt_model)
+{
   std::size_t materials_size = materials.size();
   std::vector<unsigned int> tiny_obj_id_to_color_id(materials_size,
                                                     default_color_id);
@@ -435,7 +402,7 @@ volInt::polyhedron raw_obj_to_volInt_model(
   for(std::size_t cur_mat = 0; cur_mat < materials_size; ++cur_mat)
   {
     std::size_t base_name_size = 0;
-    const std::string &cur_mat_name = materials[cur_mat].name;
+    const std::string &cur_mat_name = materials[cur_mat];
     // Checking whether first part of cur_mat_name is "body_offset_".
     if(!std::strncmp(cur_mat_name.c_str(),
                      wavefront_obj::body_mat_str_el_1.c_str(),
@@ -517,161 +484,62 @@ volInt::polyhedron raw_obj_to_volInt_model(
 
   if(type == c3d::c3d_type::main_of_mechos)
   {
-    // Checking wheels.
-    int n_wheels = volInt_model.wheels.size();
-    std::vector<int> missed_wheels;
-    std::vector<int> out_of_range_wheels;
-    missed_wheels.reserve(n_wheels);
-    out_of_range_wheels.reserve(n_wheels);
-    for(std::size_t cur_wheel = 0; cur_wheel < n_wheels; ++cur_wheel)
-    {
-      if(!volInt_model.wheels.count(cur_wheel))
-      {
-        missed_wheels.push_back(cur_wheel);
-      }
-    }
-    for(std::size_t cur_wheel : volInt_model.wheels)
-    {
-      if(cur_wheel >= n_wheels)
-      {
-        out_of_range_wheels.push_back(cur_wheel);
-      }
-    }
-
-    if(missed_wheels.size() || out_of_range_wheels.size())
-    {
-      std::string missed_wheels_str;
-      std::string out_of_range_wheels_str;
-
-      if(missed_wheels.size() == 1)
-      {
-        missed_wheels_str.append("Missed wheel:\n");
-      }
-      else
-      {
-        missed_wheels_str.append("Missed wheels:\n");
-      }
-      for(std::size_t missed_wheel : missed_wheels)
-      {
-        missed_wheels_str.append(std::to_string(missed_wheel + 1) + "\n");
-      }
-
-      if(out_of_range_wheels.size() == 1)
-      {
-        missed_wheels_str.append("Out of range wheel:" "\n");
-      }
-      else
-      {
-        missed_wheels_str.append("Out of range wheels:" "\n");
-      }
-      for(std::size_t out_of_range_wheel : out_of_range_wheels)
-      {
-        out_of_range_wheels_str.append(
-          std::to_string(out_of_range_wheel + 1) + "\n");
-      }
-
-      throw std::runtime_error(
-        "In " + input_file_name_error + " file " +
-        input_file_path_arg.string() +
-        " wheels order is wrong. " + '\n' +
-        "It is assumed that all wheels are numbered " +
-        "from 1 to number of wheels." + '\n' +
-        missed_wheels_str +
-        out_of_range_wheels_str +
-        '\n');
-    }
+    raw_obj_to_volInt_helper_check_wheels(input_file_path_arg,
+                                          input_file_name_error,
+                                          volInt_model);
   }
 
 
 
 
 
-  // Writing data to volInt::polyhedron.
-  std::size_t cur_vert_pos = 0;
-  for(std::size_t vert_ind = 0; vert_ind < num_verts; ++vert_ind)
+  // Vertices, normals and vertex indices of faces are already written.
+  // Assigning materials.
+  for(std::size_t cur_poly_num = 0,
+        poly_size = volInt_model.faces.size();
+      cur_poly_num < poly_size;
+      ++cur_poly_num)
   {
-    for(std::size_t coord_el = 0; coord_el < volInt::axes_num; ++coord_el)
+    volInt::face &cur_volint_poly_ref = volInt_model.faces[cur_poly_num];
+    int tiny_obj_mat_id = face_material_ids[cur_poly_num];
+
+    if(tiny_obj_mat_id < 0)
     {
-      volInt_model.verts[vert_ind][coord_el] = attrib.vertices[cur_vert_pos];
-      ++cur_vert_pos;
+      cur_volint_poly_ref.color_id =  default_color_id;
+      cur_volint_poly_ref.wheel_id =  volInt::invalid::wheel_id;
+      cur_volint_poly_ref.weapon_id = volInt::invalid::weapon_id;
     }
-  }
-
-  std::size_t cur_vert_norm_pos = 0;
-  for(std::size_t norm_ind = 0; norm_ind < num_vert_norms; ++norm_ind)
-  {
-    for(std::size_t coord_el = 0; coord_el < volInt::axes_num; ++coord_el)
+    else
     {
-      volInt_model.vertNorms[norm_ind][coord_el] =
-        attrib.normals[cur_vert_norm_pos];
-      ++cur_vert_norm_pos;
+      cur_volint_poly_ref.color_id =
+        tiny_obj_id_to_color_id[tiny_obj_mat_id];
+      cur_volint_poly_ref.wheel_id =
+        tiny_obj_id_to_wheel_id[tiny_obj_mat_id];
+      cur_volint_poly_ref.weapon_id =
+        tiny_obj_id_to_weapon_id[tiny_obj_mat_id];
     }
-  }
 
-  std::size_t cur_volint_poly_num = 0;
-  for(const auto &shape : shapes)
-  {
-    std::size_t cur_poly_pos = 0;
-    for(std::size_t cur_poly_num = 0,
-          poly_size = shape.mesh.num_face_vertices.size();
-        cur_poly_num < poly_size;
-        ++cur_poly_num)
+
+
+    // If polygon is saved in actual *.m3d/*.a3d model,
+    // check whether normal indices were specified in *.obj file.
+    if(cur_volint_poly_ref.color_id <
+       c3d::color::string_to_id::max_colors_ids)
     {
-      volInt::face &cur_volint_poly_ref =
-        volInt_model.faces[cur_volint_poly_num];
-      ++cur_volint_poly_num;
       for(std::size_t cur_poly_vert_num = 0;
-          cur_poly_vert_num < expected_n_verts_per_poly;
+          cur_poly_vert_num < cur_volint_poly_ref.vertNorms.size();
           ++cur_poly_vert_num)
       {
-        const tinyobj::index_t &cur_tinyobj_index_ref =
-          shape.mesh.indices[cur_poly_pos];
-        ++cur_poly_pos;
-        cur_volint_poly_ref.verts[cur_poly_vert_num] =
-          cur_tinyobj_index_ref.vertex_index;
-        cur_volint_poly_ref.vertNorms[cur_poly_vert_num] =
-          cur_tinyobj_index_ref.normal_index;
-      }
-      int tiny_obj_mat_id = shape.mesh.material_ids[cur_poly_num];
-
-      if(tiny_obj_mat_id < 0)
-      {
-        cur_volint_poly_ref.color_id =  default_color_id;
-        cur_volint_poly_ref.wheel_id =  volInt::invalid::wheel_id;
-        cur_volint_poly_ref.weapon_id = volInt::invalid::weapon_id;
-      }
-      else
-      {
-        cur_volint_poly_ref.color_id =
-          tiny_obj_id_to_color_id[tiny_obj_mat_id];
-        cur_volint_poly_ref.wheel_id =
-          tiny_obj_id_to_wheel_id[tiny_obj_mat_id];
-        cur_volint_poly_ref.weapon_id =
-          tiny_obj_id_to_weapon_id[tiny_obj_mat_id];
-      }
-
-
-
-      // If polygon is saved in actual *.m3d/*.a3d model,
-      // check whether normal indices were specified in *.obj file.
-      if(cur_volint_poly_ref.color_id <
-         c3d::color::string_to_id::max_colors_ids)
-      {
-        for(std::size_t cur_poly_vert_num = 0;
-            cur_poly_vert_num < expected_n_verts_per_poly;
-            ++cur_poly_vert_num)
+        if(cur_volint_poly_ref.vertNorms[cur_poly_vert_num] < 0)
         {
-          if(cur_volint_poly_ref.vertNorms[cur_poly_vert_num] < 0)
-          {
-            throw std::runtime_error(
-              "In " + input_file_name_error + " file " +
-              input_file_path_arg.string() +
-              " face " + std::to_string(cur_poly_num) +
-              " has no normal index specified for vertex " +
-              std::to_string(cur_poly_vert_num) + "." + '\n' +
-              "All faces which are part of actual model" +
-              " must have specified normal indices.");
-          }
+          throw std::runtime_error(
+            "In " + input_file_name_error + " file " +
+            input_file_path_arg.string() +
+            " face " + std::to_string(cur_poly_num) +
+            " has no normal index specified for vertex " +
+            std::to_string(cur_poly_vert_num) + "." + '\n' +
+            "All faces which are part of actual model" +
+            " must have specified normal indices.");
         }
       }
     }
@@ -680,6 +548,70 @@ volInt::polyhedron raw_obj_to_volInt_model(
 
 
   volInt_model.faces_calc_params();
+}
+
+
+
+volInt::polyhedron raw_obj_to_volInt_model(
+  const boost::filesystem::path &input_file_path_arg,
+  const std::string &input_file_name_error,
+  c3d::c3d_type type,
+  unsigned int default_color_id,
+  std::size_t jobs_num)
+{
+  file_view obj_data(input_file_path_arg, input_file_name_error);
+  return raw_obj_to_volInt_model(obj_data.data(),
+                                 obj_data.size(),
+                                 input_file_path_arg,
+                                 input_file_name_error,
+                                 type,
+                                 default_color_id,
+                                 jobs_num);
+}
+
+volInt::polyhedron raw_obj_to_volInt_model(
+  const char *obj_data,
+  std::size_t obj_data_size,
+  const boost::filesystem::path &input_file_path_arg,
+  const std::string &input_file_name_error,
+  c3d::c3d_type type,
+  unsigned int default_color_id,
+  std::size_t jobs_num)
+{
+  // Parsing *.obj file in parallel chunks.
+
+  unsigned char expected_n_verts_per_poly;
+  std::string expected_n_verts_per_poly_err_str;
+  if(type == c3d::c3d_type::regular ||
+     type == c3d::c3d_type::main_of_mechos)
+  {
+    expected_n_verts_per_poly = c3d::regular_model_vertices_per_polygon;
+    expected_n_verts_per_poly_err_str = "regular";
+  }
+  if(type == c3d::c3d_type::bound)
+  {
+    expected_n_verts_per_poly = c3d::bound_model_vertices_per_polygon;
+    expected_n_verts_per_poly_err_str = "bound";
+  }
+
+  volInt::polyhedron volInt_model;
+  wavefront_obj_parser parser(obj_data,
+                              obj_data_size,
+                              input_file_path_arg,
+                              input_file_name_error);
+  parser.parse(expected_n_verts_per_poly,
+               expected_n_verts_per_poly_err_str,
+               jobs_num,
+               volInt_model);
+  volInt_model.wavefront_obj_path = input_file_path_arg.string();
+
+  raw_obj_to_volInt_helper_assign_materials(input_file_path_arg,
+                                            input_file_name_error,
+                                            type,
+                                            default_color_id,
+                                            parser.material_names,
+                                            parser.face_material_ids,
+                                            volInt_model);
 
   return volInt_model;
 }
@@ -688,10 +620,53 @@ volInt::polyhedron raw_obj_to_volInt_model(
 
 
 
-void save_volInt_as_wavefront_obj(
+void volInt_to_wavefront_obj_data_helper_append_material(
+  const volInt::polyhedron &volInt_model,
+  const volInt::face &cur_face,
+  std::string &obj_data)
+{
+  if(cur_face.color_id == c3d::color::string_to_id::body)
+  {
+    obj_data.append(
+      wavefront_obj::body_mat_str_el_1 +
+      std::to_string(volInt_model.bodyColorOffset) +
+      wavefront_obj::body_mat_str_el_2 +
+      std::to_string(volInt_model.bodyColorShift));
+  }
+  else
+  {
+    obj_data.append(
+      c3d::color::ids.by<c3d::color::id>().at(cur_face.color_id));
+  }
+
+  if(cur_face.wheel_id != volInt::invalid::wheel_id)
+  {
+    obj_data.append(wavefront_obj::wheel_mat_marker);
+    if(volInt_model.wheels_steer.count(cur_face.wheel_id))
+    {
+      obj_data.append(wavefront_obj::wheel_steer_mat_marker);
+    }
+    if(volInt_model.wheels_ghost.count(cur_face.wheel_id))
+    {
+      obj_data.append(wavefront_obj::wheel_ghost_mat_marker);
+    }
+    obj_data.append(
+      wavefront_obj::mat_separator +
+      std::to_string(cur_face.wheel_id + 1));
+  }
+  else if(cur_face.weapon_id != volInt::invalid::weapon_id)
+  {
+    obj_data.append(
+      wavefront_obj::weapon_mat_marker +
+      wavefront_obj::mat_separator +
+      std::to_string(cur_face.weapon_id + 1));
+  }
+}
+
+
+
+std::string volInt_to_wavefront_obj_data(
   const std::unordered_map<std::string, volInt::polyhedron> &c3d_models,
-  const boost::filesystem::path &output_path,
-  const std::string &output_file_name_error,
   const std::string &float_precision_objs_string,
   std::size_t expected_medium_vertex_size,
   std::size_t expected_medium_normal_size)
@@ -778,45 +753,10 @@ void save_volInt_as_wavefront_obj(
          cur_poly_weapon_id != previous_weapon_id)
       {
         obj_data.append("usemtl ");
-        if(c3d_model.second.faces[cur_poly_num].color_id ==
-           c3d::color::string_to_id::body)
-        {
-          obj_data.append(
-            wavefront_obj::body_mat_str_el_1 +
-            std::to_string(c3d_model.second.bodyColorOffset) +
-            wavefront_obj::body_mat_str_el_2 +
-            std::to_string(c3d_model.second.bodyColorShift));
-        }
-        else
-        {
-          obj_data.append(
-            c3d::color::ids.by<c3d::color::id>().at(
-              c3d_model.second.faces[cur_poly_num].color_id));
-        }
-
-        if(cur_poly_wheel_id != volInt::invalid::wheel_id)
-        {
-          obj_data.append(wavefront_obj::wheel_mat_marker);
-          if(c3d_model.second.wheels_steer.count(cur_poly_wheel_id))
-          {
-            obj_data.append(wavefront_obj::wheel_steer_mat_marker);
-          }
-          if(c3d_model.second.wheels_ghost.count(cur_poly_wheel_id))
-          {
-            obj_data.append(wavefront_obj::wheel_ghost_mat_marker);
-          }
-          obj_data.append(
-            wavefront_obj::mat_separator +
-            std::to_string(cur_poly_wheel_id + 1));
-        }
-        else if(cur_poly_weapon_id != volInt::invalid::weapon_id)
-        {
-          obj_data.append(
-            wavefront_obj::weapon_mat_marker +
-            wavefront_obj::mat_separator +
-            std::to_string(cur_poly_weapon_id + 1));
-        }
-
+        volInt_to_wavefront_obj_data_helper_append_material(
+          c3d_model.second,
+          c3d_model.second.faces[cur_poly_num],
+          obj_data);
         obj_data.push_back('\n');
 
         previous_color_id =  c3d_model.second.faces[cur_poly_num].color_id;
@@ -849,11 +789,7 @@ void save_volInt_as_wavefront_obj(
     last_norm_ind += norm_num;
   }
 
-
-  save_file(output_path,
-            obj_data,
-            file_flag::none,
-            output_file_name_error);
+  return obj_data;
 }
 
 
@@ -6,11 +6,11 @@
 #include "vangers_3d_model_constants.hpp"
 
 #include "file_operations.hpp"
+#include "wavefront_obj_parser.hpp"
 #include "to_string_precision.hpp"
 #include "vangers_3d_model_operations.hpp"
 
 #include "volInt.hpp"
-#include "tiny_obj_loader.h"
 
 #include <boost/filesystem.hpp>
 
@@ -96,17 +96,49 @@ void raw_obj_to_volInt_helper_get_weapon_num(
   std::string mat_name,
   std::size_t base_name_size,
   std::vector<int> &tiny_obj_id_to_weapon_id);
+void raw_obj_to_volInt_helper_check_wheels(
+  const boost::filesystem::path &input_file_path_arg,
+  const std::string &input_file_name_error,
+  const volInt::polyhedron &volInt_model);
+// Assigns color, wheel and weapon IDs to faces by names of their materials.
+// face_material_ids are indices in materials, -1 if face has no material.
+void raw_obj_to_volInt_helper_assign_materials(
+  const boost::filesystem::path &input_file_path_arg,
+  const std::string &input_file_name_error,
+  c3d::c3d_type type,
+  unsigned int default_color_id,
+  const std::vector<std::string> &materials,
+  const std::vector<int> &face_material_ids,
+  volInt::polyhedron &volInt_model);
 
+// jobs_num is number of threads used to parse *.obj file.
 volInt::polyhedron raw_obj_to_volInt_model(
   const boost::filesystem::path &input_file_path_arg,
   const std::string &input_file_name_error,
   c3d::c3d_type type,
-  unsigned int default_color_id);
-
-void save_volInt_as_wavefront_obj(
+  unsigned int default_color_id,
+  std::size_t jobs_num);
+// Parses *.obj file data which is already in memory.
+// input_file_path_arg is used for error messages and wavefront_obj_path.
+volInt::polyhedron raw_obj_to_volInt_model(
+  const char *obj_data,
+  std::size_t obj_data_size,
+  const boost::filesystem::path &input_file_path_arg,
+  const std::string &input_file_name_error,
+  c3d::c3d_type type,
+  unsigned int default_color_id,
+  std::size_t jobs_num);
+
+// Appends material name which is used for cur_face in "usemtl" line.
+void volInt_to_wavefront_obj_data_helper_append_material(
+  const volInt::polyhedron &volInt_model,
+  const volInt::face &cur_face,
+  std::string &obj_data);
+
+// Returns content of *.obj file with c3d_models
+// which is saved in text mode.
+std::string volInt_to_wavefront_obj_data(
   const std::unordered_map<std::string, volInt::polyhedron> &c3d_models,
-  const boost::filesystem::path &output_path,
-  const std::string &output_file_name_error,
   const std::string &float_precision_objs_string =
     float_precision_objs_string_default,
   std::size_t expected_medium_vertex_size = expected_vertex_size_default,
@@ -0,0 +1,762 @@
+#include "wavefront_obj_parser.hpp"
+
+
+
+namespace tractor_converter{
+namespace helpers{
+
+
+
+wavefront_obj_parser::wavefront_obj_parser(
+  const char *data_arg,
+  std::size_t size_arg,
+  const boost::filesystem::path &input_file_path_arg,
+  const std::string &input_file_name_error_arg)
+: m_data(data_arg),
+  m_size(size_arg),
+  input_file_path(input_file_path_arg),
+  input_file_name_error(input_file_name_error_arg),
+  verts_num(0),
+  vert_norms_num(0),
+  faces_num(0)
+{
+}
+
+
+
+void wavefront_obj_parser::parse(
+  std::size_t expected_verts_per_poly,
+  const std::string &expected_verts_per_poly_err_str,
+  std::size_t jobs_num,
+  volInt::polyhedron &volInt_model)
+{
+  std::size_t chunks_num =
+    std::min(jobs_num,
+             m_size / wavefront_obj_parser_min_chunk_size);
+  split_chunks(std::max(chunks_num, static_cast<std::size_t>(1)));
+
+  thread_pool pool(chunks.size());
+
+  for(auto &&cur_chunk : chunks)
+  {
+    pool.add_task([this, &cur_chunk](){ parse_chunk_faces(cur_chunk); });
+  }
+  pool.wait();
+
+  merge_chunks();
+
+  for(auto &&cur_chunk : chunks)
+  {
+    pool.add_task(
+      [this, &cur_chunk, expected_verts_per_poly]()
+      {
+        check_chunk_faces(cur_chunk, expected_verts_per_poly);
+      });
+  }
+  pool.wait();
+
+
+
+  std::size_t saved_faces_num = 0;
+  for(auto &&cur_chunk : chunks)
+  {
+    if(cur_chunk.max_vert_ind >= static_cast<int>(verts_num) ||
+       cur_chunk.min_vert_ind < 0)
+    {
+      throw std::runtime_error(
+        error_prefix() + "Vertex indices out of bounds.");
+    }
+    if(cur_chunk.max_vert_norm_ind >= static_cast<int>(vert_norms_num) ||
+       cur_chunk.min_vert_norm_ind < -1)
+    {
+      throw std::runtime_error(
+        error_prefix() + "Vertex normal indices out of bounds.");
+    }
+  }
+  for(auto &&cur_chunk : chunks)
+  {
+    if(cur_chunk.bad_verts_num)
+    {
+      throw std::runtime_error(
+        error_prefix() + "Expected " +
+        expected_verts_per_poly_err_str +
+        " object with " +
+        std::to_string(expected_verts_per_poly) +
+        " vertices per polygon. Found polygon with " +
+        std::to_string(cur_chunk.bad_verts_num) +
+        " vertices.");
+    }
+    cur_chunk.saved_faces_offset = saved_faces_num;
+    saved_faces_num += cur_chunk.saved_faces_num;
+  }
+
+
+
+  volInt_model = volInt::polyhedron(verts_num,
+                                    vert_norms_num,
+                                    saved_faces_num,
+                                    expected_verts_per_poly);
+  face_material_ids.resize(saved_faces_num);
+
+  for(auto &&cur_chunk : chunks)
+  {
+    pool.add_task(
+      [this, &cur_chunk, &volInt_model]()
+      {
+        save_chunk(cur_chunk, volInt_model);
+      });
+  }
+  pool.wait();
+}
+
+
+
+std::pair<const char *, const char *> wavefront_obj_parser::get_line(
+  const char *pos,
+  const char *end)
+{
+  const char *line_end = pos;
+  while(line_end < end && *line_end != '\n' && *line_end != '\r')
+  {
+    ++line_end;
+  }
+  return std::make_pair(pos, line_end);
+}
+
+
+
+const char *wavefront_obj_parser::get_token(const char *line_begin,
+                                            const char *line_end)
+{
+  while(line_begin < line_end && is_space(*line_begin))
+  {
+    ++line_begin;
+  }
+  return line_begin;
+}
+
+
+
+bool wavefront_obj_parser::is_space(char c)
+{
+  return c == ' ' || c == '\t';
+}
+
+
+
+bool wavefront_obj_parser::is_new_line(char c)
+{
+  return c == '\r' || c == '\n' || c == '\0';
+}
+
+
+
+// Checks whether token starts with keyword followed by space.
+bool wavefront_obj_parser::token_is(const char *token,
+                                   const char *line_end,
+                                   const char *keyword,
+                                   std::size_t keyword_size)
+{
+  return static_cast<std::size_t>(line_end - token) > keyword_size &&
+         !std::strncmp(token, keyword, keyword_size) &&
+         is_space(token[keyword_size]);
+}
+
+
+
+// Same algorithm as tryParseDouble() of tiny_obj_loader
+// so parsed numbers are exactly the same.
+bool wavefront_obj_parser::parse_double(const char *s,
+                                        const char *s_end,
+                                        double *result)
+{
+  if(s >= s_end)
+  {
+    return false;
+  }
+
+  double mantissa = 0.0;
+  // Exponent is applied as "mantissa * 5^exponent * 2^exponent".
+  int exponent = 0;
+
+  char sign = '+';
+  char exp_sign = '+';
+  const char *curr = s;
+
+  // How many characters were read in a loop.
+  int read = 0;
+  // Tells whether a loop terminated due to reaching s_end.
+  bool end_not_reached = false;
+
+  if(*curr == '+' || *curr == '-')
+  {
+    sign = *curr;
+    ++curr;
+  }
+  else if(!std::isdigit(static_cast<unsigned char>(*curr)))
+  {
+    return false;
+  }
+
+  // Reading integer part.
+  end_not_reached = (curr != s_end);
+  while(end_not_reached && std::isdigit(static_cast<unsigned char>(*curr)))
+  {
+    mantissa *= 10;
+    mantissa += static_cast<int>(*curr - '0');
+    ++curr;
+    ++read;
+    end_not_reached = (curr != s_end);
+  }
+
+  if(!read)
+  {
+    return false;
+  }
+
+  if(end_not_reached)
+  {
+    bool read_exponent = true;
+
+    // Reading decimal part.
+    if(*curr == '.')
+    {
+      ++curr;
+      read = 1;
+      end_not_reached = (curr != s_end);
+      while(end_not_reached &&
+            std::isdigit(static_cast<unsigned char>(*curr)))
+      {
+        static const double pow_lut[] =
+        {
+          1.0, 0.1, 0.01, 0.001, 0.0001, 0.00001, 0.000001, 0.0000001,
+        };
+        const int lut_entries = sizeof(pow_lut) / sizeof(pow_lut[0]);
+
+        mantissa += static_cast<int>(*curr - '0') *
+                    (read < lut_entries ?
+                       pow_lut[read] : std::pow(10.0, -read));
+        ++read;
+        ++curr;
+        end_not_reached = (curr != s_end);
+      }
+    }
+    else if(*curr != 'e' && *curr != 'E')
+    {
+      read_exponent = false;
+    }
+
+    // Reading exponent part.
+    if(read_exponent && end_not_reached && (*curr == 'e' || *curr == 'E'))
+    {
+      ++curr;
+      end_not_reached = (curr != s_end);
+      if(end_not_reached && (*curr == '+' || *curr == '-'))
+      {
+        exp_sign = *curr;
+        ++curr;
+      }
+      else if(!std::isdigit(static_cast<unsigned char>(*curr)))
+      {
+        // Empty exponent is not allowed.
+        return false;
+      }
+
+      read = 0;
+      end_not_reached = (curr != s_end);
+      while(end_not_reached &&
+            std::isdigit(static_cast<unsigned char>(*curr)))
+      {
+        exponent *= 10;
+        exponent += static_cast<int>(*curr - '0');
+        ++curr;
+        ++read;
+        end_not_reached = (curr != s_end);
+      }
+      exponent *= (exp_sign == '+' ? 1 : -1);
+      if(!read)
+      {
+        return false;
+      }
+    }
+  }
+
+  *result = (sign == '+' ? 1 : -1) *
+            (exponent ?
+               std::ldexp(mantissa * std::pow(5.0, exponent), exponent) :
+               mantissa);
+  return true;
+}
+
+
+
+double wavefront_obj_parser::parse_real(const char **token)
+{
+  (*token) += std::strspn((*token), " \t");
+  const char *end = (*token) + std::strcspn((*token), " \t\r");
+  double val = 0.0;
+  parse_double((*token), end, &val);
+  (*token) = end;
+  return val;
+}
+
+
+
+bool wavefront_obj_parser::parse_index(const char **token,
+                                       std::size_t cur_num,
+                                       std::vector<int> &inds,
+                                       std::vector<std::size_t> &rel_inds)
+{
+  int ind = std::atoi(*token);
+  if(ind > 0)
+  {
+    inds.push_back(ind - 1);
+  }
+  else if(ind < 0)
+  {
+    rel_inds.push_back(inds.size());
+    inds.push_back(static_cast<int>(cur_num) + ind);
+  }
+  else
+  {
+    // Zero index is not allowed.
+    return false;
+  }
+  (*token) += std::strcspn((*token), "/ \t\r");
+  return true;
+}
+
+
+
+// Parses "i", "i/j", "i//k" and "i/j/k" vertices of face.
+bool wavefront_obj_parser::parse_face(const char *token, chunk &cur_chunk)
+{
+  token += 2;
+  token += std::strspn(token, " \t");
+
+  std::size_t face_verts_num = 0;
+  while(!is_new_line(token[0]))
+  {
+    if(!parse_index(&token,
+                    cur_chunk.verts_num,
+                    cur_chunk.vert_inds,
+                    cur_chunk.rel_vert_inds))
+    {
+      return false;
+    }
+
+    bool has_norm = false;
+    if(token[0] == '/')
+    {
+      ++token;
+      if(token[0] != '/')
+      {
+        // Texture coordinate index is only checked.
+        if(!std::atoi(token))
+        {
+          return false;
+        }
+        token += std::strcspn(token, "/ \t\r");
+      }
+      if(token[0] == '/')
+      {
+        ++token;
+        if(!parse_index(&token,
+                        cur_chunk.vert_norms_num,
+                        cur_chunk.vert_norm_inds,
+                        cur_chunk.rel_vert_norm_inds))
+        {
+          return false;
+        }
+        has_norm = true;
+      }
+    }
+    if(!has_norm)
+    {
+      cur_chunk.vert_norm_inds.push_back(-1);
+    }
+
+    ++face_verts_num;
+    token += std::strspn(token, " \t\r");
+  }
+
+  cur_chunk.face_verts_nums.push_back(face_verts_num);
+  return true;
+}
+
+
+
+std::size_t wavefront_obj_parser::get_line_num(const char *line_begin) const
+{
+  std::size_t line_num = 1;
+  for(const char *cur = m_data; cur < line_begin; ++cur)
+  {
+    if(*cur == '\n')
+    {
+      ++line_num;
+    }
+    else if(*cur == '\r')
+    {
+      ++line_num;
+      if(cur + 1 < line_begin && cur[1] == '\n')
+      {
+        ++cur;
+      }
+    }
+  }
+  return line_num;
+}
+
+
+
+std::string wavefront_obj_parser::error_prefix() const
+{
+  return "Error while loading " + input_file_name_error +
+         " file " + input_file_path.string() +
+         " as " + ext::readable::wavefront_obj + ". ";
+}
+
+
+
+void wavefront_obj_parser::split_chunks(std::size_t chunks_num)
+{
+  chunks.assign(chunks_num, chunk());
+
+  const char *end = m_data + m_size;
+  const char *cur_begin = m_data;
+  for(std::size_t cur_chunk = 0; cur_chunk < chunks_num; ++cur_chunk)
+  {
+    chunks[cur_chunk].begin = cur_begin;
+    if(cur_chunk + 1 == chunks_num)
+    {
+      cur_begin = end;
+    }
+    else
+    {
+      // Moving end of chunk to the beginning of the next line.
+      cur_begin = std::max(cur_begin,
+                           m_data + m_size / chunks_num * (cur_chunk + 1));
+      while(cur_begin < end &&
+            cur_begin > m_data &&
+            cur_begin[-1] != '\n' &&
+            cur_begin[-1] != '\r')
+      {
+        ++cur_begin;
+      }
+    }
+    chunks[cur_chunk].end = cur_begin;
+  }
+}
+
+
+
+void wavefront_obj_parser::parse_chunk_faces(chunk &cur_chunk)
+{
+  std::string line_buf;
+
+  const char *pos = cur_chunk.begin;
+  while(pos < cur_chunk.end)
+  {
+    std::pair<const char *, const char *> line =
+      get_line(pos, cur_chunk.end);
+    pos = line.second + 1;
+
+    const char *token = get_token(line.first, line.second);
+    if(token == line.second)
+    {
+      continue;
+    }
+
+    if(token_is(token, line.second, "v", 1))
+    {
+      ++cur_chunk.verts_num;
+    }
+    else if(token_is(token, line.second, "vn", 2))
+    {
+      ++cur_chunk.vert_norms_num;
+    }
+    else if(token_is(token, line.second, "f", 1))
+    {
+      line_buf.assign(token, line.second);
+      if(!parse_face(line_buf.c_str(), cur_chunk))
+      {
+        cur_chunk.bad_face_line = line.first;
+        return;
+      }
+    }
+    else if(token_is(token, line.second, "usemtl", 6))
+    {
+      line_buf.assign(token, line.second);
+      statement cur_statement;
+      cur_statement.type = statement_type::usemtl;
+      cur_statement.faces_before = cur_chunk.face_verts_nums.size();
+      cur_statement.line_begin = line.first;
+      // Name ends at the end of line or at null character.
+      cur_statement.material_name = line_buf.c_str() + 7;
+      cur_chunk.statements.push_back(std::move(cur_statement));
+    }
+    else if(token_is(token, line.second, "g", 1) ||
+            token_is(token, line.second, "o", 1))
+    {
+      statement cur_statement;
+      cur_statement.type =
+        token[0] == 'g' ? statement_type::group : statement_type::object;
+      cur_statement.faces_before = cur_chunk.face_verts_nums.size();
+      cur_statement.line_begin = line.first;
+
+      if(cur_statement.type == statement_type::group &&
+         !cur_chunk.empty_group_line)
+      {
+        line_buf.assign(token + 1, line.second);
+        if(!line_buf.c_str()[std::strspn(line_buf.c_str(), " \t")])
+        {
+          cur_chunk.empty_group_line = line.first;
+        }
+      }
+
+      cur_chunk.statements.push_back(std::move(cur_statement));
+    }
+  }
+}
+
+
+
+void wavefront_obj_parser::merge_chunks()
+{
+  for(const auto &cur_chunk : chunks)
+  {
+    if(cur_chunk.bad_face_line)
+    {
+      throw std::runtime_error(
+        error_prefix() + "Failed to parse face at line " +
+        std::to_string(get_line_num(cur_chunk.bad_face_line)) +
+        ". Zero or malformed indices are not allowed.");
+    }
+  }
+  for(const auto &cur_chunk : chunks)
+  {
+    if(cur_chunk.empty_group_line)
+    {
+      throw std::runtime_error(
+        error_prefix() + "Empty group name at line " +
+        std::to_string(get_line_num(cur_chunk.empty_group_line)) + ".");
+    }
+  }
+
+
+
+  std::map<std::string, int> material_map;
+  int cur_material_id = -1;
+  // Face where current shape begins.
+  std::size_t shape_begin = 0;
+  // Face after the last "usemtl" which changed material.
+  std::size_t group_begin = 0;
+
+  for(auto &&cur_chunk : chunks)
+  {
+    cur_chunk.verts_offset = verts_num;
+    cur_chunk.vert_norms_offset = vert_norms_num;
+    cur_chunk.faces_offset = faces_num;
+    cur_chunk.first_material_id = cur_material_id;
+
+    for(auto &&cur_statement : cur_chunk.statements)
+    {
+      std::size_t cur_face = faces_num + cur_statement.faces_before;
+      if(cur_statement.type == statement_type::usemtl)
+      {
+        int new_material_id = -1;
+        auto material = material_map.find(cur_statement.material_name);
+        if(material != material_map.end())
+        {
+          new_material_id = material->second;
+        }
+        else if(!cur_statement.material_name.empty())
+        {
+          new_material_id = material_names.size();
+          material_map[cur_statement.material_name] = new_material_id;
+          material_names.push_back(cur_statement.material_name);
+        }
+
+        if(new_material_id != cur_material_id)
+        {
+          group_begin = cur_face;
+          cur_material_id = new_material_id;
+        }
+      }
+      else
+      {
+        // tinyobj::LoadObj() drops the shape on "o"
+        // if there are no faces after the last change of material.
+        if(cur_statement.type == statement_type::object &&
+           group_begin == cur_face &&
+           shape_begin != group_begin)
+        {
+          dropped_faces.push_back(std::make_pair(shape_begin, group_begin));
+        }
+        shape_begin = cur_face;
+        group_begin = cur_face;
+      }
+      cur_statement.material_id = cur_material_id;
+    }
+
+    verts_num += cur_chunk.verts_num;
+    vert_norms_num += cur_chunk.vert_norms_num;
+    faces_num += cur_chunk.face_verts_nums.size();
+  }
+}
+
+
+
+bool wavefront_obj_parser::face_is_saved(std::size_t face_ind) const
+{
+  auto dropped = std::upper_bound(
+    dropped_faces.begin(), dropped_faces.end(),
+    face_ind,
+    [](std::size_t ind, const std::pair<std::size_t, std::size_t> &range)
+    {
+      return ind < range.first;
+    });
+  return dropped == dropped_faces.begin() ||
+         face_ind >= std::prev(dropped)->second;
+}
+
+
+
+void wavefront_obj_parser::check_chunk_faces(
+  chunk &cur_chunk,
+  std::size_t expected_verts_per_poly)
+{
+  for(const auto ind_pos : cur_chunk.rel_vert_inds)
+  {
+    cur_chunk.vert_inds[ind_pos] += cur_chunk.verts_offset;
+  }
+  for(const auto ind_pos : cur_chunk.rel_vert_norm_inds)
+  {
+    cur_chunk.vert_norm_inds[ind_pos] += cur_chunk.vert_norms_offset;
+  }
+
+  cur_chunk.max_vert_ind = -1;
+  cur_chunk.min_vert_ind = 0;
+  cur_chunk.max_vert_norm_ind = -1;
+  cur_chunk.min_vert_norm_ind = -1;
+  for(const auto vert_ind : cur_chunk.vert_inds)
+  {
+    cur_chunk.max_vert_ind = std::max(cur_chunk.max_vert_ind, vert_ind);
+    cur_chunk.min_vert_ind = std::min(cur_chunk.min_vert_ind, vert_ind);
+  }
+  for(const auto vert_norm_ind : cur_chunk.vert_norm_inds)
+  {
+    cur_chunk.max_vert_norm_ind =
+      std::max(cur_chunk.max_vert_norm_ind, vert_norm_ind);
+    cur_chunk.min_vert_norm_ind =
+      std::min(cur_chunk.min_vert_norm_ind, vert_norm_ind);
+  }
+
+  cur_chunk.saved_faces_num = 0;
+  cur_chunk.bad_verts_num = 0;
+  for(std::size_t face_ind = 0,
+        chunk_faces_num = cur_chunk.face_verts_nums.size();
+      face_ind < chunk_faces_num;
+      ++face_ind)
+  {
+    std::size_t face_verts_num = cur_chunk.face_verts_nums[face_ind];
+    // Faces with less than 3 vertices are skipped by tinyobj::LoadObj().
+    if(face_verts_num < 3 ||
+       !face_is_saved(cur_chunk.faces_offset + face_ind))
+    {
+      continue;
+    }
+    if(face_verts_num != expected_verts_per_poly)
+    {
+      cur_chunk.bad_verts_num = face_verts_num;
+      return;
+    }
+    ++cur_chunk.saved_faces_num;
+  }
+}
+
+
+
+void wavefront_obj_parser::save_chunk(chunk &cur_chunk,
+                                      volInt::polyhedron &volInt_model)
+{
+  std::string line_buf;
+
+  std::size_t cur_vert = cur_chunk.verts_offset;
+  std::size_t cur_vert_norm = cur_chunk.vert_norms_offset;
+  const char *pos = cur_chunk.begin;
+  while(pos < cur_chunk.end)
+  {
+    std::pair<const char *, const char *> line =
+      get_line(pos, cur_chunk.end);
+    pos = line.second + 1;
+
+    const char *token = get_token(line.first, line.second);
+    volInt::vector_3d *coords;
+    if(token_is(token, line.second, "v", 1))
+    {
+      coords = &volInt_model.verts[cur_vert];
+      ++cur_vert;
+    }
+    else if(token_is(token, line.second, "vn", 2))
+    {
+      coords = &volInt_model.vertNorms[cur_vert_norm];
+      ++cur_vert_norm;
+    }
+    else
+    {
+      continue;
+    }
+
+    line_buf.assign(token, line.second);
+    const char *coord_token = line_buf.c_str() + (token[1] == 'n' ? 3 : 2);
+    for(auto &&coord : *coords)
+    {
+      coord = parse_real(&coord_token);
+    }
+  }
+
+
+
+  std::size_t cur_statement = 0;
+  int cur_material_id = cur_chunk.first_material_id;
+  std::size_t cur_saved_face = cur_chunk.saved_faces_offset;
+  std::size_t cur_ind_pos = 0;
+  for(std::size_t face_ind = 0,
+        chunk_faces_num = cur_chunk.face_verts_nums.size();
+      face_ind < chunk_faces_num;
+      ++face_ind)
+  {
+    while(cur_statement < cur_chunk.statements.size() &&
+          cur_chunk.statements[cur_statement].faces_before <= face_ind)
+    {
+      cur_material_id = cur_chunk.statements[cur_statement].material_id;
+      ++cur_statement;
+    }
+
+    std::size_t face_verts_num = cur_chunk.face_verts_nums[face_ind];
+    std::size_t face_ind_pos = cur_ind_pos;
+    cur_ind_pos += face_verts_num;
+    if(face_verts_num < 3 ||
+       !face_is_saved(cur_chunk.faces_offset + face_ind))
+    {
+      continue;
+    }
+
+    volInt::face &cur_face = volInt_model.faces[cur_saved_face];
+    std::copy(cur_chunk.vert_inds.begin() + face_ind_pos,
+              cur_chunk.vert_inds.begin() + face_ind_pos + face_verts_num,
+              cur_face.verts.begin());
+    std::copy(
+      cur_chunk.vert_norm_inds.begin() + face_ind_pos,
+      cur_chunk.vert_norm_inds.begin() + face_ind_pos + face_verts_num,
+      cur_face.vertNorms.begin());
+    face_material_ids[cur_saved_face] = cur_material_id;
+    ++cur_saved_face;
+  }
+}
+
+
+
+} // namespace helpers
+} // namespace tractor_converter
@@ -0,0 +1,182 @@
+#ifndef TRACTOR_CONVERTER_WAVEFRONT_OBJ_PARSER_H
+#define TRACTOR_CONVERTER_WAVEFRONT_OBJ_PARSER_H
+
+#include "defines.hpp"
+
+#include "thread_pool.hpp"
+
+#include "volInt.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <exception>
+#include <stdexcept>
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <cmath>
+#include <climits>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+
+namespace tractor_converter{
+namespace helpers{
+
+
+
+// Files are split into chunks of at least this size,
+// so small files are parsed by the calling thread only.
+const std::size_t wavefront_obj_parser_min_chunk_size = 262144;
+
+
+
+// Parses *.obj file data straight into volInt::polyhedron.
+//
+// Data is split at line boundaries into chunks which are parsed
+// in parallel. Lines are interpreted the same way
+// as tinyobj::LoadObj() did it with no material reader:
+// "mtllib" is skipped and materials are created by "usemtl"
+// in order of their first appearance.
+// Faces which tinyobj::LoadObj() drops are dropped too:
+// faces with less than 3 vertices and faces of shape
+// which ends with "usemtl" right before "o".
+// Texture coordinates, lines, tags and smoothing groups are ignored.
+class wavefront_obj_parser
+{
+
+public:
+
+  wavefront_obj_parser(const char *data_arg,
+                       std::size_t size_arg,
+                       const boost::filesystem::path &input_file_path_arg,
+                       const std::string &input_file_name_error_arg);
+
+  // Creates volInt_model with sizes found in file
+  // and writes vertices, normals and faces into it.
+  // Up to jobs_num threads are used.
+  // Pass 1 when already running inside a job of another thread pool.
+  void parse(std::size_t expected_verts_per_poly,
+             const std::string &expected_verts_per_poly_err_str,
+             std::size_t jobs_num,
+             volInt::polyhedron &volInt_model);
+
+  // Names of materials in order of their first "usemtl".
+  std::vector<std::string> material_names;
+  // Index in material_names for each face of parsed model.
+  // -1 if face has no material.
+  std::vector<int> face_material_ids;
+
+private:
+
+  enum class statement_type{usemtl, group, object};
+
+  struct statement
+  {
+    statement_type type;
+    // Number of faces of chunk which are before statement.
+    std::size_t faces_before;
+    const char *line_begin;
+    std::string material_name;
+    // Set while merging chunks.
+    int material_id;
+  };
+
+  struct chunk
+  {
+    const char *begin;
+    const char *end;
+
+    std::size_t verts_num;
+    std::size_t vert_norms_num;
+
+    // Number of vertices of each face.
+    std::vector<std::size_t> face_verts_nums;
+    // Zero-based indices of all faces one after another.
+    // -1 normal index means that it's not specified.
+    std::vector<int> vert_inds;
+    std::vector<int> vert_norm_inds;
+    // Positions of negative relative indices in vert_inds and
+    // vert_norm_inds. They are relative to the beginning of chunk
+    // until offset of chunk is added.
+    std::vector<std::size_t> rel_vert_inds;
+    std::vector<std::size_t> rel_vert_norm_inds;
+
+    std::vector<statement> statements;
+
+    // Line of the first face which failed to parse.
+    const char *bad_face_line;
+    // Line of the first "g" statement with empty name.
+    const char *empty_group_line;
+
+    // Set while merging chunks.
+    std::size_t verts_offset;
+    std::size_t vert_norms_offset;
+    std::size_t faces_offset;
+    int first_material_id;
+
+    // Set while checking faces.
+    std::size_t saved_faces_num;
+    std::size_t saved_faces_offset;
+    int max_vert_ind;
+    int min_vert_ind;
+    int max_vert_norm_ind;
+    int min_vert_norm_ind;
+    std::size_t bad_verts_num;
+  };
+
+  static std::pair<const char *, const char *> get_line(const char *pos,
+                                                         const char *end);
+  static const char *get_token(const char *line_begin, const char *line_end);
+  static bool is_space(char c);
+  static bool is_new_line(char c);
+  static bool token_is(const char *token,
+                       const char *line_end,
+                       const char *keyword,
+                       std::size_t keyword_size);
+
+  static bool parse_double(const char *s, const char *s_end, double *result);
+  static double parse_real(const char **token);
+  static bool parse_index(const char **token,
+                          std::size_t cur_num,
+                          std::vector<int> &inds,
+                          std::vector<std::size_t> &rel_inds);
+  static bool parse_face(const char *token, chunk &cur_chunk);
+
+  std::size_t get_line_num(const char *line_begin) const;
+  std::string error_prefix() const;
+
+  void split_chunks(std::size_t chunks_num);
+  void parse_chunk_faces(chunk &cur_chunk);
+  void merge_chunks();
+  bool face_is_saved(std::size_t face_ind) const;
+  void check_chunk_faces(chunk &cur_chunk,
+                         std::size_t expected_verts_per_poly);
+  void save_chunk(chunk &cur_chunk, volInt::polyhedron &volInt_model);
+
+  const char *m_data;
+  std::size_t m_size;
+  boost::filesystem::path input_file_path;
+  std::string input_file_name_error;
+
+  std::vector<chunk> chunks;
+  std::size_t verts_num;
+  std::size_t vert_norms_num;
+  std::size_t faces_num;
+  // Sorted ranges [first, second) of faces which are dropped.
+  std::vector<std::pair<std::size_t, std::size_t>> dropped_faces;
+
+};
+
+
+
+} // namespace helpers
+} // namespace tractor_converter
+
+#endif // TRACTOR_CONVERTER_WAVEFRONT_OBJ_PARSER_H
@@ -119,6 +119,7 @@ wavefront_obj_to_m3d_model::wavefront_obj_to_m3d_model(
   model_name = input_m3d_path_arg.filename().string();
 
   prm_scale_size = 0.0;
+  m3d_out = nullptr;
 }
 
 
@@ -230,8 +231,15 @@ void wavefront_obj_to_m3d_model::mechos_wavefront_objs_to_m3d()
 
 
 
-  // Allocating enough space for *.m3d file.
-  m3d_data = std::string(m3d_file_size, '\0');
+  boost::filesystem::path file_to_save = output_m3d_path;
+  file_to_save.append(model_name + ext::m3d,
+                      boost::filesystem::path::codecvt());
+
+  // Records are written straight into file of exact size.
+  file_output_view m3d_file(file_to_save,
+                            m3d_file_size,
+                            output_file_name_error);
+  m3d_out = m3d_file.data();
   m3d_data_cur_pos = 0;
 
   write_c3d(cur_main_model);
@@ -254,14 +262,8 @@ void wavefront_obj_to_m3d_model::mechos_wavefront_objs_to_m3d()
     write_m3d_weapon_slots();
   }
 
-
-  boost::filesystem::path file_to_save = output_m3d_path;
-  file_to_save.append(model_name + ext::m3d,
-                      boost::filesystem::path::codecvt());
-  save_file(file_to_save,
-            m3d_data,
-            file_flag::binary,
-            output_file_name_error);
+  m3d_file.commit();
+  m3d_out = nullptr;
 
 
 
@@ -277,7 +279,8 @@ void wavefront_obj_to_m3d_model::mechos_wavefront_objs_to_m3d()
              prm_file_output,
              input_file_name_error,
              output_file_name_error,
-             prm_scale_size);
+             prm_scale_size,
+             static_cast<bool>(flags & obj_to_m3d_flag::pack_sicher_cfg));
 }
 
 
@@ -337,8 +340,15 @@ volInt::polyhedron wavefront_obj_to_m3d_model::weapon_wavefront_objs_to_m3d()
 
 
 
-  // Allocating enough space for *.m3d file.
-  m3d_data = std::string(m3d_file_size, '\0');
+  boost::filesystem::path file_to_save = output_m3d_path;
+  file_to_save.append(model_name + ext::m3d,
+                      boost::filesystem::path::codecvt());
+
+  // Records are written straight into file of exact size.
+  file_output_view m3d_file(file_to_save,
+                            m3d_file_size,
+                            output_file_name_error);
+  m3d_out = m3d_file.data();
   m3d_data_cur_pos = 0;
 
   write_c3d(cur_main_model);
@@ -347,14 +357,8 @@ volInt::polyhedron wavefront_obj_to_m3d_model::weapon_wavefront_objs_to_m3d()
   write_var_to_m3d<int, std::int32_t>(weapon_slots_existence);
 
 
-
-  boost::filesystem::path file_to_save = output_m3d_path;
-  file_to_save.append(model_name + ext::m3d,
-                      boost::filesystem::path::codecvt());
-  save_file(file_to_save,
-            m3d_data,
-            file_flag::binary,
-            output_file_name_error);
+  m3d_file.commit();
+  m3d_out = nullptr;
 
   return cur_main_model;
 }
@@ -397,8 +401,15 @@ void wavefront_obj_to_m3d_model::animated_wavefront_objs_to_a3d()
 
   std::size_t a3d_file_size = get_a3d_file_size(&animated_models);
 
-  // Allocating enough space for *.a3d file.
-  m3d_data = std::string(a3d_file_size, '\0');
+  boost::filesystem::path file_to_save = output_m3d_path;
+  file_to_save.append(model_name + ext::a3d,
+                      boost::filesystem::path::codecvt());
+
+  // Records are written straight into file of exact size.
+  file_output_view a3d_file(file_to_save,
+                            a3d_file_size,
+                            output_file_name_error);
+  m3d_out = a3d_file.data();
   m3d_data_cur_pos = 0;
 
   write_a3d_header_data();
@@ -408,14 +419,8 @@ void wavefront_obj_to_m3d_model::animated_wavefront_objs_to_a3d()
   }
 
 
-
-  boost::filesystem::path file_to_save = output_m3d_path;
-  file_to_save.append(model_name + ext::a3d,
-                      boost::filesystem::path::codecvt());
-  save_file(file_to_save,
-            m3d_data,
-            file_flag::binary,
-            output_file_name_error);
+  a3d_file.commit();
+  m3d_out = nullptr;
 }
 
 
@@ -472,8 +477,15 @@ void wavefront_obj_to_m3d_model::other_wavefront_objs_to_m3d()
 
 
 
-  // Allocating enough space for *.m3d file.
-  m3d_data = std::string(m3d_file_size, '\0');
+  boost::filesystem::path file_to_save = output_m3d_path;
+  file_to_save.append(model_name + ext::m3d,
+                      boost::filesystem::path::codecvt());
+
+  // Records are written straight into file of exact size.
+  file_output_view m3d_file(file_to_save,
+                            m3d_file_size,
+                            output_file_name_error);
+  m3d_out = m3d_file.data();
   m3d_data_cur_pos = 0;
 
   write_c3d(cur_main_model);
@@ -482,14 +494,8 @@ void wavefront_obj_to_m3d_model::other_wavefront_objs_to_m3d()
   write_var_to_m3d<int, std::int32_t>(weapon_slots_existence);
 
 
-
-  boost::filesystem::path file_to_save = output_m3d_path;
-  file_to_save.append(model_name + ext::m3d,
-                      boost::filesystem::path::codecvt());
-  save_file(file_to_save,
-            m3d_data,
-            file_flag::binary,
-            output_file_name_error);
+  m3d_file.commit();
+  m3d_out = nullptr;
 }
 
 
@@ -641,11 +647,11 @@ void wavefront_obj_to_m3d_model::read_file_cfg_m3d(
       }
       catch(std::exception &e)
       {
-        std::cout << "Failed to retrieve custom center of mass from " <<
+        thread_log() << "Failed to retrieve custom center of mass from " <<
           input_file_name_error << " file " <<
           main_model.wavefront_obj_path << '\n';
-        std::cout << e.what() << '\n';
-        std::cout <<
+        thread_log() << e.what() << '\n';
+        thread_log() <<
           "Center of mass is not overwritten for main model." << '\n';
       }
     }
@@ -665,14 +671,14 @@ void wavefront_obj_to_m3d_model::read_file_cfg_m3d(
         }
         else
         {
-          std::cout <<
+          thread_log() <<
             "In config file " << config_file_str <<
             " unexpected number of values specified for " <<
             option::per_file::name::custom_inertia_tensor_main << '\n';
-          std::cout <<
+          thread_log() <<
             "Expected " << std::to_string(J_cfg_num_of_values) <<
             ", got  " << custom_J_main.size() << '\n';
-          std::cout <<
+          thread_log() <<
             "Inertia tensor is not overwritten for main model." << '\n';
         }
       }
@@ -715,12 +721,12 @@ void wavefront_obj_to_m3d_model::read_file_cfg_m3d(
           }
           catch(std::exception &e)
           {
-            std::cout <<
+            thread_log() <<
               "Failed to retrieve custom center of mass from " <<
               input_file_name_error << " file " <<
               (*debris_models)[cur_debris].wavefront_obj_path << '\n';
-            std::cout << e.what() << '\n';
-            std::cout <<
+            thread_log() << e.what() << '\n';
+            thread_log() <<
               "Center of mass is not overwritten for debris model " <<
               std::to_string(cur_debris + 1) << "." << '\n';
           }
@@ -752,14 +758,14 @@ void wavefront_obj_to_m3d_model::read_file_cfg_m3d(
             }
             else
             {
-              std::cout <<
+              thread_log() <<
                 "In config file " << config_file_str <<
                 " unexpected number of values specified " <<
                 "for " << cur_custom_J_option << '\n';
-              std::cout <<
+              thread_log() <<
                 "Expected " << std::to_string(J_cfg_num_of_values) <<
                 ", got  " << custom_J_debris.size() << '\n';
-              std::cout <<
+              thread_log() <<
                 "Inertia tensor is not overwritten for debris " <<
                 std::to_string(cur_debris + 1) << "." << '\n';
             }
@@ -770,7 +776,7 @@ void wavefront_obj_to_m3d_model::read_file_cfg_m3d(
   }
   catch(std::exception &)
   {
-    std::cout <<
+    thread_log() <<
       "Failed to get config options for model " << model_name << '\n';
     throw;
   }
@@ -877,12 +883,12 @@ void wavefront_obj_to_m3d_model::read_file_cfg_a3d(
         }
         catch(std::exception &e)
         {
-          std::cout <<
+          thread_log() <<
             "Failed to retrieve custom center of mass from " <<
             input_file_name_error << " file " <<
             animated_models[cur_animated].wavefront_obj_path << '\n';
-          std::cout << e.what() << '\n';
-          std::cout <<
+          thread_log() << e.what() << '\n';
+          thread_log() <<
             "Center of mass is not overwritten for animated model " <<
             std::to_string(cur_animated + 1) << "." << '\n';
         }
@@ -914,14 +920,14 @@ void wavefront_obj_to_m3d_model::read_file_cfg_a3d(
           }
           else
           {
-            std::cout <<
+            thread_log() <<
               "In config file " << config_file_str <<
               " unexpected number of values specified " <<
               "for " << cur_custom_J_option << '\n';
-            std::cout <<
+            thread_log() <<
               "Expected " << std::to_string(J_cfg_num_of_values) <<
               ", got  " << custom_J_animated.size() << '\n';
-            std::cout <<
+            thread_log() <<
               "Inertia tensor is not overwritten for animated model " <<
               std::to_string(cur_animated + 1) << "." << '\n';
           }
@@ -931,7 +937,7 @@ void wavefront_obj_to_m3d_model::read_file_cfg_a3d(
   }
   catch(std::exception &)
   {
-    std::cout << "Failed to get config options for model " <<
+    thread_log() << "Failed to get config options for model " <<
       model_name << '\n';
     throw;
   }
@@ -943,10 +949,14 @@ volInt::polyhedron wavefront_obj_to_m3d_model::read_obj(
   const boost::filesystem::path &obj_input_file_path,
   c3d::c3d_type cur_c3d_type)
 {
-  return raw_obj_to_volInt_model(obj_input_file_path,
-                                 input_file_name_error,
-                                 cur_c3d_type,
-                                 default_c3d_material_id);
+  return raw_obj_to_volInt_model_cached(
+    obj_input_file_path,
+    input_file_name_error,
+    cur_c3d_type,
+    default_c3d_material_id,
+    static_cast<bool>(flags & obj_to_m3d_flag::use_obj_binary_cache),
+    // Models are already converted in parallel jobs.
+    1);
 }
 
 
@@ -989,11 +999,11 @@ std::deque<volInt::polyhedron>
 
 
 
-std::vector<double> wavefront_obj_to_m3d_model::get_medium_vert(
+point wavefront_obj_to_m3d_model::get_medium_vert(
   const volInt::polyhedron &model,
   const volInt::face &poly)
 {
-  std::vector<double> medium_vert(volInt::axes_num, 0.0);
+  point medium_vert = volInt::vector_3d_filled(0.0);
   // For polygon with zero_reserved color, middle point is different.
   // middle_x is either xmax of *.m3d or -xmax of *.m3d.
   // middle_y is either ymax of *.m3d or -ymax of *.m3d.
@@ -1003,10 +1013,10 @@ std::vector<double> wavefront_obj_to_m3d_model::get_medium_vert(
      c3d::color::string_to_id::zero_reserved)
   {
     // Preserved sign.
-    std::vector<double> extreme_abs_coords(volInt::axes_num, 0.0);
+    point extreme_abs_coords = volInt::vector_3d_filled(0.0);
     for(const auto vert_ind : poly.verts)
     {
-      const std::vector<double> &vert = model.verts[vert_ind];
+      const point &vert = model.verts[vert_ind];
       for(std::size_t cur_coord = 0; cur_coord < volInt::axes_num; ++cur_coord)
       {
         if(std::abs(vert[cur_coord]) >
@@ -1046,10 +1056,10 @@ std::vector<double> wavefront_obj_to_m3d_model::get_medium_vert(
 }
 
 
-void wavefront_obj_to_m3d_model::write_vertex(const std::vector<double> &vert)
+void wavefront_obj_to_m3d_model::write_vertex(const point &vert)
 {
-  write_vec_var_to_m3d_scaled<double, float>(vert);
-  write_vec_var_to_m3d_scaled_rounded<double, char>(vert);
+  write_point_to_m3d_scaled<float>(vert);
+  write_point_to_m3d_scaled_rounded<char>(vert);
   write_var_to_m3d<int, std::int32_t>(c3d::vertex::default_sort_info);
 }
 
@@ -1064,10 +1074,10 @@ void wavefront_obj_to_m3d_model::write_vertices(
 
 
 void wavefront_obj_to_m3d_model::write_normal(
-  const std::vector<double> &norm,
+  const point &norm,
   bitflag<normal_flag> flags = normal_flag::sort_info)
 {
-  write_vec_var_to_m3d_rounded<double, char>(
+  write_point_to_m3d_rounded<char>(
     volInt::vector_scale(c3d::vector_scale_val, norm));
   write_var_to_m3d<unsigned char, unsigned char>(
     c3d::normal::default_n_power);
@@ -1099,8 +1109,8 @@ void wavefront_obj_to_m3d_model::write_polygon(
 
   write_normal(poly.norm, normal_flag::none);
 
-  std::vector<double> medium_vert = get_medium_vert(model, poly);
-  write_vec_var_to_m3d_scaled_rounded<double, char>(medium_vert);
+  point medium_vert = get_medium_vert(model, poly);
+  write_point_to_m3d_scaled_rounded<char>(medium_vert);
 
   // Note the reverse order of vertices.
   for(std::size_t vert_f_ind = 0, vert_f_ind_r = poly.numVerts - 1;
@@ -1140,13 +1150,43 @@ void wavefront_obj_to_m3d_model::write_polygons(
 //  buf.set(3 * num_poly * 4, XB_CUR);
 //#endif
 
+// There are 3 tables, one for each axis.
+// Each table contains indices of all polygons
+// sorted by coordinate of their middle points along the axis.
 void wavefront_obj_to_m3d_model::write_sorted_polygon_indices(
   const volInt::polyhedron &model)
 {
-  std::size_t skipped_sorted_bytes_n =
-    model.numFaces * c3d::polygon_sort_info::size;
-  std::memset(&m3d_data[m3d_data_cur_pos], 0, skipped_sorted_bytes_n);
-  m3d_data_cur_pos += skipped_sorted_bytes_n;
+  if(!(flags & obj_to_m3d_flag::generate_polygon_sort_tables))
+  {
+    std::size_t skipped_sorted_bytes_n =
+      model.numFaces * c3d::polygon_sort_info::size;
+    std::memset(m3d_out + m3d_data_cur_pos, 0, skipped_sorted_bytes_n);
+    m3d_data_cur_pos += skipped_sorted_bytes_n;
+    return;
+  }
+
+  std::vector<point> medium_verts;
+  medium_verts.reserve(model.numFaces);
+  for(const auto &poly : model.faces)
+  {
+    medium_verts.push_back(get_medium_vert(model, poly));
+  }
+
+  std::vector<int> sorted_polygons(model.numFaces);
+  for(std::size_t cur_axis = 0; cur_axis < volInt::axes_num; ++cur_axis)
+  {
+    std::iota(sorted_polygons.begin(), sorted_polygons.end(), 0);
+    // Stable sort so polygons with the same middle point coordinate
+    // keep their order and output doesn't depend on sort implementation.
+    std::stable_sort(
+      sorted_polygons.begin(), sorted_polygons.end(),
+      [&](int first, int second)
+      {
+        return medium_verts[first][cur_axis] <
+               medium_verts[second][cur_axis];
+      });
+    write_vec_var_to_m3d<int, std::int32_t>(sorted_polygons);
+  }
 }
 
 
@@ -1159,16 +1199,15 @@ void wavefront_obj_to_m3d_model::write_c3d(const volInt::polyhedron &model)
   write_var_to_m3d<int, std::int32_t>(model.numFaces);
   write_var_to_m3d<int, std::int32_t>(model.numVertTotal);
 
-  write_vec_var_to_m3d_scaled_rounded<double, std::int32_t>(model.max_point());
-  write_vec_var_to_m3d_scaled_rounded<double, std::int32_t>(model.min_point());
-  write_vec_var_to_m3d_scaled_rounded<double, std::int32_t>(
-    model.offset_point());
+  write_point_to_m3d_scaled_rounded<std::int32_t>(model.max_point());
+  write_point_to_m3d_scaled_rounded<std::int32_t>(model.min_point());
+  write_point_to_m3d_scaled_rounded<std::int32_t>(model.offset_point());
   write_var_to_m3d_scaled_rounded<double, std::int32_t>(model.rmax);
 
   write_vec_var_to_m3d<int, std::int32_t>(c3d::default_phi_psi_tetta);
 
   write_var_to_m3d_scaled<double, double>(model.volume, 3.0);
-  write_vec_var_to_m3d_scaled<double, double>(model.rcm);
+  write_point_to_m3d_scaled<double>(model.rcm);
   write_nest_vec_var_to_m3d_scaled<double, double>(model.J, 5.0);
 
   write_vertices(model);
@@ -1182,7 +1221,7 @@ void wavefront_obj_to_m3d_model::write_c3d(const volInt::polyhedron &model)
 
 void wavefront_obj_to_m3d_model::write_m3d_header_data()
 {
-  write_vec_var_to_m3d_scaled_rounded<double, std::int32_t>(max_point());
+  write_point_to_m3d_scaled_rounded<std::int32_t>(max_point());
   write_var_to_m3d_scaled_rounded<double, std::int32_t>(rmax);
   write_var_to_m3d<int, std::int32_t>(n_wheels);
   write_var_to_m3d<int, std::int32_t>(n_debris);
@@ -1195,7 +1234,7 @@ void wavefront_obj_to_m3d_model::write_m3d_header_data()
 void wavefront_obj_to_m3d_model::write_a3d_header_data()
 {
   write_var_to_m3d<int, std::int32_t>(n_models);
-  write_vec_var_to_m3d_scaled_rounded<double, std::int32_t>(max_point());
+  write_point_to_m3d_scaled_rounded<std::int32_t>(max_point());
   write_var_to_m3d_scaled_rounded<double, std::int32_t>(rmax);
   write_var_to_m3d<int, std::int32_t>(body_color_offset);
   write_var_to_m3d<int, std::int32_t>(body_color_shift);
@@ -1208,7 +1247,7 @@ void wavefront_obj_to_m3d_model::write_m3d_wheel_data(
   std::size_t wheel_id)
 {
   write_var_to_m3d<int, std::int32_t>(cur_wheel_data[wheel_id].steer);
-  write_vec_var_to_m3d_scaled<double, double>(cur_wheel_data[wheel_id].r);
+  write_point_to_m3d_scaled<double>(cur_wheel_data[wheel_id].r);
   write_var_to_m3d_scaled_rounded<double, std::int32_t>(
     cur_wheel_data[wheel_id].width);
   write_var_to_m3d_scaled_rounded<double, std::int32_t>(
@@ -1254,7 +1293,7 @@ void wavefront_obj_to_m3d_model::write_m3d_debris_data(
 
 void wavefront_obj_to_m3d_model::write_m3d_weapon_slot(std::size_t slot_id)
 {
-  write_vec_var_to_m3d_scaled_rounded<double, std::int32_t>(
+  write_point_to_m3d_scaled_rounded<std::int32_t>(
     cur_weapon_slot_data[slot_id].R_slot);
   write_var_to_m3d<int, std::int32_t>(
     volInt::radians_to_sicher_angle(
@@ -1789,9 +1828,9 @@ std::unordered_map<int, volInt::polyhedron>
       cur_wheel_model.numVertsPerPoly = v_per_poly;
 
       cur_wheel_model.verts =
-        std::vector<std::vector<double>>(cur_wheel_model.numVerts);
+        std::vector<point>(cur_wheel_model.numVerts);
       cur_wheel_model.vertNorms =
-        std::vector<std::vector<double>>(cur_wheel_model.numVertNorms);
+        std::vector<point>(cur_wheel_model.numVertNorms);
 
       cur_wheel_model.wavefront_obj_path = main_model.wavefront_obj_path;
       cur_wheel_model.wheel_id = wheel_steer_num;
@@ -2035,14 +2074,14 @@ void wavefront_obj_to_m3d_model::get_debris_data(
   {
     if(n_debris)
     {
-      std::cout << '\n';
-      std::cout << "Found " << std::to_string(debris_num) <<
+      thread_log() << '\n';
+      thread_log() << "Found " << std::to_string(debris_num) <<
         " debris for " << input_m3d_path << " model." << '\n';
     }
     else
     {
-      std::cout << '\n';
-      std::cout << "Couldn't find debris for " <<
+      thread_log() << '\n';
+      thread_log() << "Couldn't find debris for " <<
         input_m3d_path << " model." << '\n';
     }
   }
@@ -2106,7 +2145,7 @@ void wavefront_obj_to_m3d_model::center_m3d(
   std::deque<volInt::polyhedron> *debris_bound_models)
 {
   get_m3d_extreme_points_calc_c3d_extr(main_model, wheels_models);
-  std::vector<double> m3d_center = extreme_points.get_center();
+  point m3d_center = extreme_points.get_center();
 
   main_model->move_coord_system_to_point_inv_neg_vol(m3d_center);
   if(model_type == center_m3d_model::weapon)
@@ -2169,7 +2208,7 @@ void wavefront_obj_to_m3d_model::center_a3d(
   std::deque<volInt::polyhedron> *models)
 {
   get_a3d_extreme_points_calc_c3d_extr(models);
-  std::vector<double> a3d_center = extreme_points.get_center();
+  point a3d_center = extreme_points.get_center();
 
   for(auto &&model : *models)
   {
@@ -2198,20 +2237,20 @@ void wavefront_obj_to_m3d_model::get_scale_helper_set_scale_from_rmax()
   double prm_lst_scale_size = 1 / scale_size;
   if(prm_lst_scale_size - scale_cap > volInt::distinct_distance)
   {
-    std::cout << '\n';
-    std::cout << option::name::scale_cap << " " << scale_cap <<
+    thread_log() << '\n';
+    thread_log() << option::name::scale_cap << " " << scale_cap <<
       " is lower than calculated scale_size " << prm_lst_scale_size <<
       " of " << input_m3d_path << " model." << '\n';
-    std::cout << option::name::scale_cap << " is written to ";
+    thread_log() << option::name::scale_cap << " is written to ";
     if(non_mechos_scale_sizes)
     {
-      std::cout << file::game_lst;
+      thread_log() << file::game_lst;
     }
     else
     {
-      std::cout << model_name << ext::prm;
+      thread_log() << model_name << ext::prm;
     }
-    std::cout << " file instead of calculated scale_size." << '\n';
+    thread_log() << " file instead of calculated scale_size." << '\n';
     prm_lst_scale_size = scale_cap;
   }
 
@@ -2605,7 +2644,7 @@ void wavefront_obj_to_m3d_model::remove_polygons(
   model.verts.erase(
     std::remove_if(
       model.verts.begin(), model.verts.end(),
-      [&](const std::vector<double> &)
+      [&](const point &)
       {
         return !verts_to_keep.count(cur_vert_n++);
       }
@@ -2616,7 +2655,7 @@ void wavefront_obj_to_m3d_model::remove_polygons(
   model.vertNorms.erase(
     std::remove_if(
       model.vertNorms.begin(), model.vertNorms.end(),
-      [&](const std::vector<double> &)
+      [&](const point &)
       {
         return !norms_to_keep.count(cur_norm_n++);
       }
@@ -2657,7 +2696,8 @@ void create_game_lst(
   const boost::filesystem::path &where_to_save_arg,
   const std::string &input_file_name_error_arg,
   const std::string &output_file_name_error_arg,
-  const std::unordered_map<std::string, double> *non_mechos_scale_sizes_arg)
+  const std::unordered_map<std::string, double> *non_mechos_scale_sizes_arg,
+  bool pack_sicher_cfg_arg)
 {
   std::string orig_game_lst_data =
     read_file(input_file_path_arg,
@@ -2714,7 +2754,9 @@ void create_game_lst(
   cur_cfg_writer.write_until_end();
 
   save_file(where_to_save_arg,
-            cur_cfg_writer.out_str(),
+            pack_sicher_cfg_arg ?
+              sicher_cfg_pack(cur_cfg_writer.out_str()) :
+              cur_cfg_writer.out_str(),
             file_flag::binary,
             output_file_name_error_arg);
 }
@@ -2726,7 +2768,8 @@ void create_prm(
   const boost::filesystem::path &where_to_save_arg,
   const std::string &input_file_name_error_arg,
   const std::string &output_file_name_error_arg,
-  const double scale_size)
+  const double scale_size,
+  bool pack_sicher_cfg_arg)
 {
   std::string orig_prm_data =
     read_file(input_file_path_arg,
@@ -2749,7 +2792,9 @@ void create_prm(
   cur_cfg_writer.write_until_end();
 
   save_file(where_to_save_arg,
-            cur_cfg_writer.out_str(),
+            pack_sicher_cfg_arg ?
+              sicher_cfg_pack(cur_cfg_writer.out_str()) :
+              cur_cfg_writer.out_str(),
             file_flag::binary,
             output_file_name_error_arg);
 }
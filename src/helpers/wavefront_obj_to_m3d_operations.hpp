@@ -9,12 +9,13 @@
 #include "raw_num_operations.hpp"
 #include "file_operations.hpp"
 #include "to_string_precision.hpp"
+#include "thread_log.hpp"
 #include "vangers_cfg_operations.hpp"
 #include "wavefront_obj_operations.hpp"
+#include "volInt_cache_operations.hpp"
 #include "vangers_3d_model_operations.hpp"
 
 #include "volInt.hpp"
-#include "tiny_obj_loader.h"
 
 #include <boost/program_options.hpp>
 #include <boost/filesystem.hpp>
@@ -31,6 +32,7 @@
 #include <utility>
 #include <limits>
 #include <iterator>
+#include <numeric>
 #include <string>
 #include <vector>
 #include <deque>
@@ -60,6 +62,9 @@ enum class obj_to_m3d_flag
   center_model = 1,
   recalculate_vertex_normals = 2,
   generate_bound_models = 3,
+  pack_sicher_cfg = 4,
+  generate_polygon_sort_tables = 5,
+  use_obj_binary_cache = 6,
 };
 
 const std::size_t J_cfg_num_of_values = 9;
@@ -214,6 +219,10 @@ private:
   std::unordered_map<std::string, double> *non_mechos_scale_sizes;
   double prm_scale_size;
 
+  // Where write_*_to_m3d() functions write to.
+  // Points to data of file_output_view of *.m3d/*.a3d file being saved.
+  char *m3d_out;
+
 
   boost::filesystem::path file_prefix_to_path(
     const std::string &prefix,
@@ -246,7 +255,7 @@ private:
   template<typename SOURCE, typename DESTINATION>
   void write_var_to_m3d(SOURCE var)
   {
-    num_to_raw_bytes<DESTINATION>(var, m3d_data, m3d_data_cur_pos);
+    num_to_raw_bytes<DESTINATION>(var, m3d_out, m3d_data_cur_pos);
     m3d_data_cur_pos += sizeof(DESTINATION);
   }
 
@@ -271,50 +280,82 @@ private:
   }
 
 
+  // Elements are written one by one so no temporary vectors are created.
   template<typename SOURCE, typename DESTINATION>
-  void write_vec_var_to_m3d(const std::vector<SOURCE> &vec_src)
+  void write_vec_var_to_m3d(const std::vector<SOURCE> &vec)
   {
-    std::vector<DESTINATION> vec_dest =
-      cast_vec_var<SOURCE, DESTINATION>(vec_src);
-    vec_num_to_raw_bytes<DESTINATION>(vec_dest, m3d_data, m3d_data_cur_pos);
-    m3d_data_cur_pos += sizeof(DESTINATION) * vec_dest.size();
+    for(const auto el : vec)
+    {
+      write_var_to_m3d<SOURCE, DESTINATION>(el);
+    }
   }
 
   template<typename SOURCE, typename DESTINATION>
   void write_vec_var_to_m3d_rounded(const std::vector<SOURCE> &vec)
   {
-    write_vec_var_to_m3d<DESTINATION, DESTINATION>(
-      round_half_to_even_vec<SOURCE, DESTINATION>(vec));
+    for(const auto el : vec)
+    {
+      write_var_to_m3d_rounded<SOURCE, DESTINATION>(el);
+    }
   }
 
   template<typename SOURCE, typename DESTINATION>
-  void write_vec_var_to_m3d_scaled(std::vector<SOURCE> vec, double exp = 1.0)
+  void write_vec_var_to_m3d_scaled(const std::vector<SOURCE> &vec,
+                                   double exp = 1.0)
   {
-    scale_vec_trunc<SOURCE>(vec, exp);
-    write_vec_var_to_m3d<SOURCE, DESTINATION>(vec);
+    for(const auto el : vec)
+    {
+      write_var_to_m3d_scaled<SOURCE, DESTINATION>(el, exp);
+    }
   }
 
   template<typename SOURCE, typename DESTINATION>
   void write_vec_var_to_m3d_scaled_rounded(
     const std::vector<SOURCE> &vec, double exp = 1.0)
   {
-    write_vec_var_to_m3d_rounded<scaled_float, DESTINATION>(
-      scale_vec<SOURCE>(vec, exp));
+    for(const auto el : vec)
+    {
+      write_var_to_m3d_scaled_rounded<SOURCE, DESTINATION>(el, exp);
+    }
+  }
+
+
+  // Coordinates are written one by one so no temporary vectors are created.
+  template<typename DESTINATION>
+  void write_point_to_m3d_rounded(const point &pt)
+  {
+    for(const auto coord : pt)
+    {
+      write_var_to_m3d_rounded<double, DESTINATION>(coord);
+    }
+  }
+
+  template<typename DESTINATION>
+  void write_point_to_m3d_scaled(const point &pt, double exp = 1.0)
+  {
+    for(const auto coord : pt)
+    {
+      write_var_to_m3d_scaled<double, DESTINATION>(coord, exp);
+    }
+  }
+
+  template<typename DESTINATION>
+  void write_point_to_m3d_scaled_rounded(const point &pt, double exp = 1.0)
+  {
+    for(const auto coord : pt)
+    {
+      write_var_to_m3d_scaled_rounded<double, DESTINATION>(coord, exp);
+    }
   }
 
 
   template<typename SOURCE, typename DESTINATION>
   void write_nest_vec_var_to_m3d(
-    const std::vector<std::vector<SOURCE>> &nest_vec_src)
+    const std::vector<std::vector<SOURCE>> &nest_vec)
   {
-    std::vector<std::vector<DESTINATION>> nest_vec_dest =
-      cast_nest_vec_var<SOURCE, DESTINATION>(nest_vec_src);
-    nest_vec_num_to_raw_bytes<DESTINATION>(nest_vec_dest,
-                                           m3d_data,
-                                           m3d_data_cur_pos);
-    for(const auto &vec_dest : nest_vec_dest)
+    for(const auto &vec : nest_vec)
     {
-      m3d_data_cur_pos += sizeof(DESTINATION) * vec_dest.size();
+      write_vec_var_to_m3d<SOURCE, DESTINATION>(vec);
     }
   }
 
@@ -322,35 +363,41 @@ private:
   void write_nest_vec_var_to_m3d_rounded(
     const std::vector<std::vector<SOURCE>> &nest_vec)
   {
-    write_nest_vec_var_to_m3d<DESTINATION, DESTINATION>(
-      round_half_to_even_nest_vec<SOURCE, DESTINATION>(nest_vec));
+    for(const auto &vec : nest_vec)
+    {
+      write_vec_var_to_m3d_rounded<SOURCE, DESTINATION>(vec);
+    }
   }
 
   template<typename SOURCE, typename DESTINATION>
   void write_nest_vec_var_to_m3d_scaled(
-    std::vector<std::vector<SOURCE>> nest_vec, double exp = 1.0)
+    const std::vector<std::vector<SOURCE>> &nest_vec, double exp = 1.0)
   {
-    scale_nest_vec_trunc<SOURCE>(nest_vec, exp);
-    write_nest_vec_var_to_m3d<SOURCE, DESTINATION>(nest_vec);
+    for(const auto &vec : nest_vec)
+    {
+      write_vec_var_to_m3d_scaled<SOURCE, DESTINATION>(vec, exp);
+    }
   }
 
   template<typename SOURCE, typename DESTINATION>
   void write_nest_vec_var_to_m3d_scaled_rounded(
     const std::vector<std::vector<SOURCE>> &nest_vec, double exp = 1.0)
   {
-    write_nest_vec_var_to_m3d_rounded<scaled_float, DESTINATION>(
-      scale_nest_vec<SOURCE>(nest_vec, exp));
+    for(const auto &vec : nest_vec)
+    {
+      write_vec_var_to_m3d_scaled_rounded<SOURCE, DESTINATION>(vec, exp);
+    }
   }
 
 
 
-  std::vector<double> get_medium_vert(const volInt::polyhedron &model,
-                                      const volInt::face &poly);
+  point get_medium_vert(const volInt::polyhedron &model,
+                        const volInt::face &poly);
 
-  void write_vertex(const std::vector<double> &vert);
+  void write_vertex(const point &vert);
   void write_vertices(const volInt::polyhedron &model);
 
-  void write_normal(const std::vector<double> &norm,
+  void write_normal(const point &norm,
                     bitflag<normal_flag> flags);
   void write_normals(const volInt::polyhedron &model);
 
@@ -522,14 +569,16 @@ void create_game_lst(
   const boost::filesystem::path &where_to_save_arg,
   const std::string &input_file_name_error_arg,
   const std::string &output_file_name_error_arg,
-  const std::unordered_map<std::string, double> *non_mechos_scale_sizes_arg);
+  const std::unordered_map<std::string, double> *non_mechos_scale_sizes_arg,
+  bool pack_sicher_cfg_arg);
 
 void create_prm(
   const boost::filesystem::path &input_file_path_arg,
   const boost::filesystem::path &where_to_save_arg,
   const std::string &input_file_name_error_arg,
   const std::string &output_file_name_error_arg,
-  const double scale_size);
+  const double scale_size,
+  bool pack_sicher_cfg_arg);
 
 void mechos_wavefront_objs_to_m3d(
   const boost::filesystem::path &input_m3d_path_arg,
@@ -34,6 +34,8 @@ namespace option{
     const std::string pal_for_each_file = "pal_for_each_file";
     const std::string pal = "pal";
     const std::string pal_dir = "pal_dir";
+    const std::string tga_rle_compression = "tga_rle_compression";
+    const std::string tga_bottom_left_origin = "tga_bottom_left_origin";
     const std::string dir_to_compare = "dir_to_compare";
     const std::string items_bmp = "items_bmp";
     const std::string map = "map";
@@ -66,8 +68,13 @@ namespace option{
     const std::string gen_bound_layers_num = "generate_bound_layers_num";
     const std::string gen_bound_area_threshold =
       "generate_bound_area_threshold";
+    const std::string gen_polygon_sort_tables =
+      "generate_polygon_sort_tables";
+    const std::string obj_binary_cache = "obj_binary_cache";
+    const std::string pack_sicher_cfg = "pack_sicher_cfg";
     const std::string mtl_n_wheels = "mtl_n_wheels";
     const std::string mtl_body_offs = "mtl_body_offs";
+    const std::string jobs = "jobs";
   } // namespace name
 
   namespace default_val{
@@ -76,6 +83,8 @@ namespace option{
     const bool reversed =                            false;
     const bool usage_pal_for_each_file =             false;
     const bool pal_for_each_file =                   false;
+    const bool tga_rle_compression =                 false;
+    const bool tga_bottom_left_origin =              false;
     const bool items_bmp =                           false;
     const bool fix_null_bytes_and_direction =        false;
     const unsigned int obj_float_precision =         6;
@@ -99,7 +108,11 @@ namespace option{
     const bool gen_bound_models =                    false;
     const std::size_t gen_bound_layers_num =         100;
     const double gen_bound_area_threshold =          0.25;
+    const bool gen_polygon_sort_tables =             false;
+    const bool obj_binary_cache =                    false;
+    const bool pack_sicher_cfg =                     false;
     const std::size_t mtl_n_wheels =                 10;
+    const std::size_t jobs =                         1;
   } // namespace default_val
 
   namespace max{
@@ -201,6 +214,8 @@ namespace ext{
 
   const std::string obj =       delimiter + "obj";
   const std::string mtl =       delimiter + "mtl";
+  // Appended to *.obj file name: "model.obj" -> "model.obj.vcache".
+  const std::string volInt_cache = delimiter + "vcache";
 
   const std::string tga =       delimiter + "tga";
   const std::string bmp =       delimiter + "bmp";
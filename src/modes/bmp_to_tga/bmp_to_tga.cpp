@@ -32,6 +32,7 @@ void bmp_to_tga_mode(const boost::program_options::variables_map options)
 
     std::string palette;
     boost::filesystem::path palette_dir;
+    helpers::case_insensitive_path_index palette_dir_index;
 
     boost::filesystem::path source_dir = 
       helpers::get_directory(
@@ -43,6 +44,7 @@ void bmp_to_tga_mode(const boost::program_options::variables_map options)
         helpers::get_directory(
           options[option::name::pal_dir].as<std::string>(),
           option::name::pal_dir);
+      palette_dir_index = helpers::case_insensitive_path_index(palette_dir);
     }
     else
     {
@@ -60,34 +62,36 @@ void bmp_to_tga_mode(const boost::program_options::variables_map options)
         options[option::name::output_dir].as<std::string>(),
         option::name::output_dir);
 
-    for(const auto &file : boost::filesystem::directory_iterator(source_dir))
-    {
-      if(boost::filesystem::is_regular_file(file.status()) &&
-         boost::algorithm::to_lower_copy(file.path().extension().string()) ==
-           ext::bmp)
+    const std::vector<boost::filesystem::path> files =
+      helpers::get_files_with_ext(source_dir, ext::bmp);
+    helpers::process_files(
+      files,
+      helpers::get_jobs_num(options[option::name::jobs].as<std::size_t>()),
+      [&](std::size_t, const boost::filesystem::path &file)
       {
-        std::string bytes =
-          helpers::read_file(
-            file.path(),
-            helpers::file_flag::binary | helpers::file_flag::read_all,
-            tga_default_header_and_pal_size - vangers_bmp_coords_size,
-            0,
-            helpers::read_all_dummy_size,
-            option::name::source_dir);
-
-        std::string current_coords =
-          bytes.substr(
-            tga_default_header_and_pal_size - vangers_bmp_coords_size,
-            vangers_bmp_coords_size);
+        // Pixels are written straight from the input file
+        // unless they have to be flipped or compressed.
+        const helpers::file_view bmp(file, option::name::source_dir);
+        if(bmp.size() < vangers_bmp_coords_size)
+        {
+          throw std::runtime_error(
+            "Image " + file.string() + " is smaller than " +
+            std::to_string(vangers_bmp_coords_size) + " bytes.");
+        }
+        const char *pixels = bmp.data() + vangers_bmp_coords_size;
+        std::size_t pixels_size = bmp.size() - vangers_bmp_coords_size;
 
 
+        // Files are converted in parallel
+        // so palette of current file is kept separately.
+        std::string file_palette;
+        const std::string *cur_palette = &palette;
         if(options[option::name::pal_for_each_file].as<bool>())
         {
           boost::filesystem::path palette_file =
-            helpers::filepath_case_insensitive_part_get(
-              palette_dir,
-              file.path().stem().string() + ext::pal);
-          palette =
+            palette_dir_index.get(
+              file.stem().string() + ext::pal);
+          file_palette =
             helpers::read_file(
               palette_file,
               helpers::file_flag::binary | helpers::file_flag::read_all,
@@ -95,29 +99,76 @@ void bmp_to_tga_mode(const boost::program_options::variables_map options)
               0,
               helpers::read_all_dummy_size,
               option::name::pal_dir);
+          cur_palette = &file_palette;
         }
 
 
-        // Inserting header.
-        bytes.replace(0, tga_header_size, tga_header_str);
+        std::string header = tga_header_str;
         // Replacing dummy width and height with real ones.
-        bytes.replace(tga_coords_pos, tga_coords_size, current_coords);
-        // Inserting palette.
-        bytes.replace(tga_default_pal_pos, tga_default_pal_size, palette);
+        header.replace(tga_coords_pos,
+                       tga_coords_size,
+                       bmp.data() + vangers_bmp_coords_pos,
+                       vangers_bmp_coords_size);
+
+        std::size_t width =
+          helpers::raw_bytes_to_num<std::uint16_t>(header, tga_coords_pos);
+        std::size_t height =
+          helpers::raw_bytes_to_num<std::uint16_t>(header, tga_coords_pos + 2);
+        std::size_t pixels_num = width * height;
+        if((options[option::name::tga_rle_compression].as<bool>() ||
+            options[option::name::tga_bottom_left_origin].as<bool>()) &&
+           pixels_size < pixels_num)
+        {
+          throw std::runtime_error(
+            "Image " + file.string() + " has less than " +
+            std::to_string(pixels_num) + " pixels.");
+        }
+
+        std::string flipped_pixels;
+        if(options[option::name::tga_bottom_left_origin].as<bool>())
+        {
+          flipped_pixels.assign(pixels, pixels_size);
+          helpers::flip_image_vertically(&flipped_pixels[0], width, height);
+          pixels = flipped_pixels.data();
+          header.replace(
+            tga_image_specification_image_descriptor_pos,
+            tga_image_specification_image_descriptor_bottom_str.size(),
+            tga_image_specification_image_descriptor_bottom_str);
+        }
+
+        std::string compressed_pixels;
+        if(options[option::name::tga_rle_compression].as<bool>())
+        {
+          // Raw packets of the worst case take 1 extra byte
+          // for each tga_rle_packet_max_pixels pixels and for each row.
+          compressed_pixels.reserve(
+            pixels_num + pixels_num / tga_rle_packet_max_pixels + height);
+          helpers::tga_rle_encode(pixels, width, height, compressed_pixels);
+          pixels = compressed_pixels.data();
+          pixels_size = compressed_pixels.size();
+          header.replace(tga_image_type_pos,
+                         tga_image_type_rle_str.size(),
+                         tga_image_type_rle_str);
+        }
 
 
 
         boost::filesystem::path file_to_save = output_dir;
         file_to_save.append(
-          boost::algorithm::to_lower_copy(file.path().stem().string()) +
+          boost::algorithm::to_lower_copy(file.stem().string()) +
             ext::tga,
           boost::filesystem::path::codecvt());
+        const std::vector<helpers::file_piece> tga_pieces =
+        {
+          {header.data(), header.size()},
+          {cur_palette->data(), cur_palette->size()},
+          {pixels, pixels_size},
+        };
         helpers::save_file(file_to_save,
-                           bytes,
+                           tga_pieces,
                            helpers::file_flag::binary,
                            option::name::output_dir);
-      }
-    }
+      });
   }
   catch(std::exception &)
   {
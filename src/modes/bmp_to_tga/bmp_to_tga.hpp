@@ -7,6 +7,11 @@
 #include "hex.hpp"
 #include "check_option.hpp"
 #include "file_operations.hpp"
+#include "thread_pool.hpp"
+#include "process_files.hpp"
+#include "raw_num_operations.hpp"
+#include "tga_class.hpp"
+#include "image_orientation.hpp"
 
 #include <boost/program_options.hpp>
 
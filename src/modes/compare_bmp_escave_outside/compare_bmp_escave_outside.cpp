@@ -6,14 +6,53 @@ namespace tractor_converter{
 
 
 
+void count_byte_pairs(const std::string &source_bytes,
+                      const std::string &compare_bytes,
+                      byte_pair_counts &counts)
+{
+  // Files are expected to have equal size.
+  // Bytes missing in shorter compared file are matched as '\0'.
+  std::size_t source_size = source_bytes.size();
+  std::size_t bytes_num = std::min(source_size, compare_bytes.size());
+  const unsigned char *source_byte =
+    reinterpret_cast<const unsigned char*>(source_bytes.data());
+  const unsigned char *compare_byte =
+    reinterpret_cast<const unsigned char*>(compare_bytes.data());
+  const unsigned char *source_end = source_byte + bytes_num;
+  int *counts_data = counts.data();
+  for(; source_byte != source_end; ++source_byte, ++compare_byte)
+  {
+    ++counts_data[
+      (static_cast<std::size_t>(*source_byte) << 8) | *compare_byte];
+  }
+  for(source_end = source_byte + (source_size - bytes_num);
+      source_byte != source_end;
+      ++source_byte)
+  {
+    ++counts_data[static_cast<std::size_t>(*source_byte) << 8];
+  }
+
+  // Terminating '\0' of source data is matched too
+  // to keep the same output as older versions.
+  std::size_t compare_terminating_byte = 0;
+  if(source_size < compare_bytes.size())
+  {
+    compare_terminating_byte =
+      static_cast<unsigned char>(compare_bytes[source_size]);
+  }
+  ++counts_data[compare_terminating_byte];
+}
+
+
+
 // There are 2 *.bmp files with equal size.
 // One is for escave, and the other is for outside of escave.
 // In this mode, this program reads both files and checks them byte by byte.
 // For example, byte at position 0 in source_dir file is 0xFF
 // while in the same file of dir_to_compare it is 0xEE.
 // So program records that for 0xFF byte there was 1 0xEE byte.
-// At the end for each possible byte value there is std::map
-// of matched bytes with number of matches.
+// At the end for each possible byte value there is number of matches
+// for each possible compared byte value.
 // For example, for 0xFF there are 3 matched byte values:
 // 0xEE matched 1000 times, 0xDD matched 2 times and 0xCC matched 500 times.
 // In that case, 0xEE value is selected for 0xFF.
@@ -42,23 +81,30 @@ void compare_bmp_escave_outside_mode(
       helpers::get_directory(
         options[option::name::dir_to_compare].as<std::string>(),
         option::name::dir_to_compare);
+    const helpers::case_insensitive_path_index
+      dir_to_compare_index(dir_to_compare);
 
-    // For each possible byte value of source_dir images,
-    // there is a map of matched bytes of dir_to_compare images.
-    // Key of the map - value of matched byte of dir_to_compare images;
-    // value of the map - number of matches.
-    std::vector<std::map<char, int>> source_compare_table =
-      std::vector<std::map<char, int>>(
-        tga_default_colors_num_in_pal,
-        std::map<char, int>());
-
-    for(const auto &file : boost::filesystem::directory_iterator(source_dir))
-    {
-      if(boost::filesystem::is_regular_file(file.status()))
+    const std::size_t byte_pairs_num =
+      tga_default_colors_num_in_pal * tga_default_colors_num_in_pal;
+
+    // Files are compared in parallel.
+    // Each file takes free counts table, fills it and gives it back,
+    // so there are no more tables than threads.
+    // Tables are summed after all files are done.
+    std::vector<std::unique_ptr<byte_pair_counts>> counts_tables;
+    std::vector<byte_pair_counts*> free_counts_tables;
+    std::mutex counts_tables_mutex;
+
+    const std::vector<boost::filesystem::path> files =
+      helpers::get_files(source_dir);
+    helpers::process_files(
+      files,
+      helpers::get_jobs_num(options[option::name::jobs].as<std::size_t>()),
+      [&](std::size_t, const boost::filesystem::path &file)
       {
         std::string bmp_bytes_source =
           helpers::read_file(
-            file.path(),
+            file,
             helpers::file_flag::binary | helpers::file_flag::read_all,
             0,
             4,
@@ -66,9 +112,8 @@ void compare_bmp_escave_outside_mode(
             option::name::source_dir);
 
         boost::filesystem::path file_to_compare =
-          helpers::filepath_case_insensitive_part_get(
-            dir_to_compare,
-            file.path().filename());
+          dir_to_compare_index.get(
+            file.filename());
         std::string bmp_bytes_to_compare =
           helpers::read_file(
             file_to_compare,
@@ -78,28 +123,45 @@ void compare_bmp_escave_outside_mode(
             helpers::read_all_dummy_size,
             option::name::dir_to_compare);
 
-        for(std::size_t current_byte_num = 0,
-              source_file_size = bmp_bytes_source.size();
-            current_byte_num <= source_file_size;
-            ++current_byte_num)
+        byte_pair_counts *counts = nullptr;
         {
-          std::map<char, int> &current_source_byte_map =
-            source_compare_table[static_cast<std::size_t>(
-              static_cast<unsigned char>(bmp_bytes_source[current_byte_num]))];
-          char current_to_compare_byte =
-            bmp_bytes_to_compare[current_byte_num];
-          if(current_source_byte_map.count(current_to_compare_byte))
+          std::lock_guard<std::mutex> lock(counts_tables_mutex);
+          if(free_counts_tables.empty())
           {
-            ++current_source_byte_map[current_to_compare_byte];
+            counts_tables.emplace_back(
+              new byte_pair_counts(byte_pairs_num, 0));
+            counts = counts_tables.back().get();
           }
           else
           {
-            current_source_byte_map[current_to_compare_byte] = 1;
+            counts = free_counts_tables.back();
+            free_counts_tables.pop_back();
           }
         }
+
+        count_byte_pairs(bmp_bytes_source, bmp_bytes_to_compare, *counts);
+
+        std::lock_guard<std::mutex> lock(counts_tables_mutex);
+        free_counts_tables.push_back(counts);
+      });
+
+    // For each possible byte value of source_dir images,
+    // there is a number of matches for each byte value
+    // of dir_to_compare images.
+    byte_pair_counts source_compare_table(byte_pairs_num, 0);
+    for(const auto &counts : counts_tables)
+    {
+      for(std::size_t cur_pair = 0; cur_pair != byte_pairs_num; ++cur_pair)
+      {
+        source_compare_table[cur_pair] += (*counts)[cur_pair];
       }
     }
 
+    // Matched bytes are listed in order of signed char values:
+    // 0x80-0xFF first, then 0x00-0x7F.
+    // XOR of counter with 0x80 gives byte value in that order.
+    const std::size_t signed_order_xor = 0x80;
+
 
 
     // Getting human readable map.
@@ -120,14 +182,23 @@ void compare_bmp_escave_outside_mode(
       {
         compare_bytes_map_readable.append(
           helpers::int_to_hex_string<std::size_t>(current_byte));
-        for(const auto &source_byte_map : source_compare_table[current_byte])
+        const int *source_byte_counts =
+          &source_compare_table[current_byte * tga_default_colors_num_in_pal];
+        for(std::size_t cur_compare = 0;
+            cur_compare != tga_default_colors_num_in_pal;
+            ++cur_compare)
         {
+          std::size_t compare_byte = cur_compare ^ signed_order_xor;
+          if(!source_byte_counts[compare_byte])
+          {
+            continue;
+          }
           compare_bytes_map_readable.push_back(' ');
           compare_bytes_map_readable.append(
-            helpers::int_to_hex_string<char>(source_byte_map.first));
+            helpers::int_to_hex_string<char>(static_cast<char>(compare_byte)));
           compare_bytes_map_readable.push_back(':');
           compare_bytes_map_readable.append(
-            std::to_string(source_byte_map.second));
+            std::to_string(source_byte_counts[compare_byte]));
         }
         compare_bytes_map_readable.push_back('\r');
         compare_bytes_map_readable.push_back('\n');
@@ -148,27 +219,25 @@ void compare_bmp_escave_outside_mode(
           current_byte != tga_default_colors_num_in_pal;
           ++current_byte)
       {
-        std::map<char, int> &current_source_byte_map =
-          source_compare_table[current_byte];
-        if(current_source_byte_map.size() == 0)
+        const int *source_byte_counts =
+          &source_compare_table[current_byte * tga_default_colors_num_in_pal];
+        // First most frequent byte is selected.
+        // Null byte if there were no matches.
+        std::size_t most_frequent_byte = 0;
+        int most_frequent_count = 0;
+        for(std::size_t cur_compare = 0;
+            cur_compare != tga_default_colors_num_in_pal;
+            ++cur_compare)
         {
-          source_compare_bytes_map.push_back('\0');
-        }
-        else
-        {
-          auto most_frequent_pair_for_source_byte =
-            std::max_element(
-              current_source_byte_map.begin(),
-              current_source_byte_map.end(),
-              [](const std::pair<char, int> &p1,
-                 const std::pair<char, int> &p2)
-              {
-                return p1.second < p2.second;
-              }
-            );
-          source_compare_bytes_map.push_back(
-            most_frequent_pair_for_source_byte->first);
+          std::size_t compare_byte = cur_compare ^ signed_order_xor;
+          if(source_byte_counts[compare_byte] > most_frequent_count)
+          {
+            most_frequent_byte = compare_byte;
+            most_frequent_count = source_byte_counts[compare_byte];
+          }
         }
+        source_compare_bytes_map.push_back(
+          static_cast<char>(most_frequent_byte));
       }
       helpers::save_file(options[option::name::output_file].as<std::string>(),
                          source_compare_bytes_map,
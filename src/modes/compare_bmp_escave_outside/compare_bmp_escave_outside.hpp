@@ -7,16 +7,21 @@
 #include "hex.hpp"
 #include "check_option.hpp"
 #include "file_operations.hpp"
+#include "thread_pool.hpp"
+#include "process_files.hpp"
 
 #include <boost/program_options.hpp>
 
 #include <exception>
 #include <stdexcept>
 
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
-#include <map>
 
 
 
@@ -24,6 +29,16 @@ namespace tractor_converter{
 
 
 
+// Number of matches for each pair of source and compared byte values.
+// Index of pair is source byte * 256 + compared byte.
+typedef std::vector<int> byte_pair_counts;
+
+void count_byte_pairs(const std::string &source_bytes,
+                      const std::string &compare_bytes,
+                      byte_pair_counts &counts);
+
+
+
 void compare_bmp_escave_outside_mode(
   const boost::program_options::variables_map options);
 
@@ -28,53 +28,40 @@ void extract_tga_pal_mode(const boost::program_options::variables_map options)
         options[option::name::output_dir].as<std::string>(),
         option::name::output_dir);
 
-    for(const auto &file : boost::filesystem::directory_iterator(source_dir))
-    {
-      if(boost::filesystem::is_regular_file(file.status()) &&
-         boost::algorithm::to_lower_copy(file.path().extension().string()) ==
-           ext::tga)
+    const std::vector<boost::filesystem::path> files =
+      helpers::get_files_with_ext(source_dir, ext::tga);
+    helpers::process_files(
+      files,
+      helpers::get_jobs_num(options[option::name::jobs].as<std::size_t>()),
+      [&](std::size_t, const boost::filesystem::path &file)
       {
-        std::string bytes =
-          helpers::read_file(
-            file.path(),
-            helpers::file_flag::binary | helpers::file_flag::read_all,
-            0,
-            0,
-            helpers::read_all_dummy_size,
-            option::name::source_dir);
+        // Only palette is copied from the file.
+        const helpers::file_view bytes(file, option::name::source_dir);
 
 
 
-        helpers::tga tga_image(bytes, 0, file.path().string());
+        helpers::tga tga_image(bytes.data(), 0, file.string());
 
 
 
-        if(tga_image.pal_size < tga_default_pal_size)
+        std::string pal = bytes.substr(tga_image.pal_start_pos,
+                                       tga_image.pal_size);
+        if(pal.size() < tga_default_pal_size)
         {
-          std::size_t missing_color_bytes =
-            (tga_default_pal_size - tga_image.pal_size);
-          bytes.replace(tga_image.pal_start_pos + tga_image.pal_size,
-                        missing_color_bytes,
-                        missing_color_bytes,
-                        '\0');
+          pal.resize(tga_default_pal_size, '\0');
         }
 
 
         boost::filesystem::path file_to_save = output_dir;
         file_to_save.append(
-          boost::algorithm::to_lower_copy(file.path().stem().string()) +
+          boost::algorithm::to_lower_copy(file.stem().string()) +
             ext::pal,
           boost::filesystem::path::codecvt());
-        helpers::write_to_file(
-          file_to_save,
-          bytes,
-          helpers::file_flag::overwrite | helpers::file_flag::binary,
-          tga_image.pal_start_pos,
-          0,
-          tga_default_pal_size,
-          option::name::output_dir);
-      }
-    }
+        helpers::save_file(file_to_save,
+                           pal,
+                           helpers::file_flag::binary,
+                           option::name::output_dir);
+      });
   }
   catch(std::exception &)
   {
@@ -6,6 +6,54 @@ namespace tractor_converter{
 
 
 
+obj_to_m3d_job::obj_to_m3d_job(
+  const helpers::vangers_3d_paths_game_dir::io_paths &io_paths_arg)
+: helpers::model_job(io_paths_arg)
+{
+}
+
+
+
+void finish_obj_to_m3d_jobs(
+  const std::vector<obj_to_m3d_job> &jobs,
+  const std::string &files_type,
+  const std::string &output_ext_readable,
+  std::unordered_map<std::string, double> &non_mechos_scale_sizes)
+{
+  helpers::finish_model_jobs(
+    jobs,
+    [&](const obj_to_m3d_job &job)
+    {
+      if(!job.exception)
+      {
+        for(const auto &scale_size : job.non_mechos_scale_sizes)
+        {
+          non_mechos_scale_sizes[scale_size.first] = scale_size.second;
+        }
+        return;
+      }
+
+      try
+      {
+        std::rethrow_exception(job.exception);
+      }
+      catch(std::exception &e)
+      {
+        std::cout << '\n';
+        std::cout << "Failed to load " << files_type << "files " <<
+          "from " << option::name::source_dir << " " <<
+          ext::readable::obj << " directory " <<
+          job.io_paths->input.string() <<
+          " and save them as " << output_ext_readable <<
+          " file in " << option::name::output_dir << " directory " <<
+          job.io_paths->output.string() << '\n';
+        std::cout << e.what() << '\n';
+      }
+    });
+}
+
+
+
 void obj_to_vangers_3d_model_mode(
   const boost::program_options::variables_map options)
 {
@@ -71,6 +119,26 @@ void obj_to_vangers_3d_model_mode(
       obj_to_m3d_flags |=
         helpers::obj_to_m3d_flag::generate_bound_models;
     }
+    if(options[option::name::gen_polygon_sort_tables].as<bool>())
+    {
+      obj_to_m3d_flags |=
+        helpers::obj_to_m3d_flag::generate_polygon_sort_tables;
+    }
+    if(options[option::name::pack_sicher_cfg].as<bool>())
+    {
+      obj_to_m3d_flags |=
+        helpers::obj_to_m3d_flag::pack_sicher_cfg;
+    }
+    bool use_obj_binary_cache =
+      options[option::name::obj_binary_cache].as<bool>();
+    if(use_obj_binary_cache)
+    {
+      obj_to_m3d_flags |=
+        helpers::obj_to_m3d_flag::use_obj_binary_cache;
+    }
+
+    std::size_t jobs_num =
+      helpers::get_jobs_num(options[option::name::jobs].as<std::size_t>());
 
     unsigned int default_c3d_material_id;
     try
@@ -114,11 +182,13 @@ void obj_to_vangers_3d_model_mode(
     {
       // Getting weapon attachment point model to get positions of weapons.
       weapon_attachment_point_model =
-        helpers::raw_obj_to_volInt_model(
+        helpers::raw_obj_to_volInt_model_cached(
           weapon_attachment_point_file,
           option::name::weapon_attachment_point_file,
           c3d::c3d_type::regular,
-          c3d::color::string_to_id::attachment_point);
+          c3d::color::string_to_id::attachment_point,
+          use_obj_binary_cache,
+          jobs_num);
       weapon_attachment_point_model_ptr = &weapon_attachment_point_model;
 
       if(!weapon_attachment_point_model_ptr->find_ref_points())
@@ -155,11 +225,13 @@ void obj_to_vangers_3d_model_mode(
       // Getting center of mass model
       // to generate inertia tensor with custom center of mass.
       center_of_mass_model =
-        helpers::raw_obj_to_volInt_model(
+        helpers::raw_obj_to_volInt_model_cached(
           center_of_mass_file,
           option::name::center_of_mass_file,
           c3d::c3d_type::regular,
-          c3d::color::string_to_id::center_of_mass);
+          c3d::color::string_to_id::center_of_mass,
+          use_obj_binary_cache,
+          jobs_num);
       center_of_mass_model_ptr = &center_of_mass_model;
 
       if(!center_of_mass_model_ptr->find_ref_points())
@@ -305,6 +377,7 @@ void obj_to_vangers_3d_model_mode(
     // Converting files for each game directory.
     // It is assumed that each game directory
     // has its own *.prm parameters and *.m3d weapon files.
+    helpers::thread_pool pool(jobs_num);
     for(const auto &game_dir : vangers_game_dirs)
     {
       std::unordered_map<std::string, double> non_mechos_scale_sizes;
@@ -312,16 +385,19 @@ void obj_to_vangers_3d_model_mode(
         &non_mechos_scale_sizes;
 
 
-      std::unordered_map<std::string, volInt::polyhedron> weapons_models;
-      weapons_models.reserve(game_dir.second.weapon_m3d.size());
-      for(const auto &m3d_io_paths : game_dir.second.weapon_m3d)
-      {
-        try
+      // Weapons must be converted first since mechos need
+      // bound sphere radius of weapons.
+      std::vector<obj_to_m3d_job> weapon_jobs =
+        helpers::get_model_jobs<obj_to_m3d_job>(game_dir.second.weapon_m3d);
+      helpers::add_model_jobs(
+        pool,
+        weapon_jobs,
+        [&](obj_to_m3d_job &job)
         {
-          weapons_models[m3d_io_paths.second.input.stem().string()] =
+          job.model =
             helpers::weapon_wavefront_objs_to_m3d(
-              m3d_io_paths.second.input,
-              m3d_io_paths.second.output,
+              job.io_paths->input,
+              job.io_paths->output,
               option::name::source_dir,
               option::name::output_dir,
               weapon_attachment_point_model_ptr,
@@ -332,19 +408,22 @@ void obj_to_vangers_3d_model_mode(
               gen_bound_layers_num,
               gen_bound_area_threshold,
               obj_to_m3d_flags,
-              non_mechos_scale_sizes_ptr);
-        }
-        catch(std::exception &e)
+              &job.non_mechos_scale_sizes);
+        });
+      pool.wait();
+      finish_obj_to_m3d_jobs(weapon_jobs,
+                             "weapon ",
+                             ext::readable::m3d,
+                             non_mechos_scale_sizes);
+
+      std::unordered_map<std::string, volInt::polyhedron> weapons_models;
+      weapons_models.reserve(weapon_jobs.size());
+      for(auto &&job : weapon_jobs)
+      {
+        if(!job.exception)
         {
-          std::cout << '\n';
-          std::cout << "Failed to load weapon files " <<
-            "from " << option::name::source_dir << " " <<
-            ext::readable::obj << " directory " <<
-            m3d_io_paths.second.input.string() <<
-            " and save them as " << ext::readable::m3d <<
-            " file in " << option::name::output_dir << " directory " <<
-            m3d_io_paths.second.output.string() << '\n';
-          std::cout << e.what() << '\n';
+          weapons_models[job.io_paths->input.stem().string()] =
+            std::move(job.model);
         }
       }
 
@@ -357,13 +436,18 @@ void obj_to_vangers_3d_model_mode(
 
 
 
-      for(const auto &m3d_io_paths : game_dir.second.mechous_m3d)
-      {
-        try
+      // Mechos, animated and other models don't depend on each other
+      // so they are converted all at once.
+      std::vector<obj_to_m3d_job> mechos_jobs =
+        helpers::get_model_jobs<obj_to_m3d_job>(game_dir.second.mechous_m3d);
+      helpers::add_model_jobs(
+        pool,
+        mechos_jobs,
+        [&](obj_to_m3d_job &job)
         {
           helpers::mechos_wavefront_objs_to_m3d(
-            m3d_io_paths.second.input,
-            m3d_io_paths.second.output,
+            job.io_paths->input,
+            job.io_paths->output,
             option::name::source_dir,
             option::name::output_dir,
             mechos_weapon_model_ptr,
@@ -376,29 +460,19 @@ void obj_to_vangers_3d_model_mode(
             gen_bound_layers_num,
             gen_bound_area_threshold,
             obj_to_m3d_flags);
-        }
-        catch(std::exception &e)
-        {
-          std::cout << '\n';
-          std::cout << "Failed to load mechos files " <<
-            "from " << option::name::source_dir << " " <<
-            ext::readable::obj << " directory " <<
-            m3d_io_paths.second.input.string() <<
-            " and save them as " << ext::readable::m3d <<
-            " file in " << option::name::output_dir << " directory " <<
-            m3d_io_paths.second.output.string() << '\n';
-          std::cout << e.what() << '\n';
-        }
-      }
+        });
 
 
-      for(const auto &a3d_io_paths : game_dir.second.animated_a3d)
-      {
-        try
+      std::vector<obj_to_m3d_job> animated_jobs =
+        helpers::get_model_jobs<obj_to_m3d_job>(game_dir.second.animated_a3d);
+      helpers::add_model_jobs(
+        pool,
+        animated_jobs,
+        [&](obj_to_m3d_job &job)
         {
           helpers::animated_wavefront_objs_to_a3d(
-            a3d_io_paths.second.input,
-            a3d_io_paths.second.output,
+            job.io_paths->input,
+            job.io_paths->output,
             option::name::source_dir,
             option::name::output_dir,
             center_of_mass_model_ptr,
@@ -406,30 +480,20 @@ void obj_to_vangers_3d_model_mode(
             scale_cap,
             max_smooth_angle,
             obj_to_m3d_flags,
-            non_mechos_scale_sizes_ptr);
-        }
-        catch(std::exception &e)
-        {
-          std::cout << '\n';
-          std::cout << "Failed to load animated files " <<
-            "from " << option::name::source_dir << " " <<
-            ext::readable::obj << " directory " <<
-            a3d_io_paths.second.input.string() <<
-            " and save them as " << ext::readable::a3d <<
-            " file in " << option::name::output_dir << " directory " <<
-            a3d_io_paths.second.output.string() << '\n';
-          std::cout << e.what() << '\n';
-        }
-      }
+            &job.non_mechos_scale_sizes);
+        });
 
 
-      for(const auto &m3d_io_paths : game_dir.second.other_m3d)
-      {
-        try
+      std::vector<obj_to_m3d_job> other_jobs =
+        helpers::get_model_jobs<obj_to_m3d_job>(game_dir.second.other_m3d);
+      helpers::add_model_jobs(
+        pool,
+        other_jobs,
+        [&](obj_to_m3d_job &job)
         {
           helpers::other_wavefront_objs_to_m3d(
-            m3d_io_paths.second.input,
-            m3d_io_paths.second.output,
+            job.io_paths->input,
+            job.io_paths->output,
             option::name::source_dir,
             option::name::output_dir,
             center_of_mass_model_ptr,
@@ -439,21 +503,23 @@ void obj_to_vangers_3d_model_mode(
             gen_bound_layers_num,
             gen_bound_area_threshold,
             obj_to_m3d_flags,
-            non_mechos_scale_sizes_ptr);
-        }
-        catch(std::exception &e)
-        {
-          std::cout << '\n';
-          std::cout << "Failed to load files " <<
-            "from " << option::name::source_dir << " " <<
-            ext::readable::obj << " directory " <<
-            m3d_io_paths.second.input.string() <<
-            " and save them as " << ext::readable::m3d <<
-            " file in " << option::name::output_dir << " directory " <<
-            m3d_io_paths.second.output.string() << '\n';
-          std::cout << e.what() << '\n';
-        }
-      }
+            &job.non_mechos_scale_sizes);
+        });
+
+
+      pool.wait();
+      finish_obj_to_m3d_jobs(mechos_jobs,
+                             "mechos ",
+                             ext::readable::m3d,
+                             non_mechos_scale_sizes);
+      finish_obj_to_m3d_jobs(animated_jobs,
+                             "animated ",
+                             ext::readable::a3d,
+                             non_mechos_scale_sizes);
+      finish_obj_to_m3d_jobs(other_jobs,
+                             "",
+                             ext::readable::m3d,
+                             non_mechos_scale_sizes);
 
 
 
@@ -461,7 +527,10 @@ void obj_to_vangers_3d_model_mode(
                                game_dir.second.game_lst.output,
                                option::name::source_dir,
                                option::name::output_dir,
-                               non_mechos_scale_sizes_ptr);
+                               non_mechos_scale_sizes_ptr,
+                               static_cast<bool>(
+                                 obj_to_m3d_flags &
+                                 helpers::obj_to_m3d_flag::pack_sicher_cfg));
     }
   }
   catch(std::exception &)
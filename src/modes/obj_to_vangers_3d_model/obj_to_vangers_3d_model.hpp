@@ -9,10 +9,11 @@
 #include "check_option.hpp"
 #include "get_option.hpp"
 #include "file_operations.hpp"
+#include "thread_pool.hpp"
+#include "model_jobs.hpp"
 #include "vangers_3d_model_operations.hpp"
 #include "wavefront_obj_to_m3d_operations.hpp"
-
-#include "tiny_obj_loader.h"
+#include "volInt_cache_operations.hpp"
 
 #include <boost/program_options.hpp>
 #include <boost/filesystem.hpp>
@@ -31,6 +32,30 @@ namespace tractor_converter{
 
 
 
+// Conversion of single model.
+// Each conversion has its own copy of data it changes
+// so conversions may run in parallel.
+struct obj_to_m3d_job : helpers::model_job
+{
+  obj_to_m3d_job(
+    const helpers::vangers_3d_paths_game_dir::io_paths &io_paths_arg);
+
+  std::unordered_map<std::string, double> non_mechos_scale_sizes;
+  // Used only for weapons.
+  volInt::polyhedron model;
+};
+
+// Must be called after all jobs are done.
+// Failed conversion doesn't stop others, its error is printed instead.
+// Merges scale sizes of converted models.
+void finish_obj_to_m3d_jobs(
+  const std::vector<obj_to_m3d_job> &jobs,
+  const std::string &files_type,
+  const std::string &output_ext_readable,
+  std::unordered_map<std::string, double> &non_mechos_scale_sizes);
+
+
+
 void obj_to_vangers_3d_model_mode(
   const boost::program_options::variables_map options);
 
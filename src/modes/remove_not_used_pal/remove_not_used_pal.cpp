@@ -39,16 +39,19 @@ void remove_not_used_pal_mode(
       helpers::get_directory(
         options[option::name::usage_pals_dir].as<std::string>(),
         option::name::usage_pals_dir);
-
-    for(const auto &file : boost::filesystem::directory_iterator(source_dir))
-    {
-      if(boost::filesystem::is_regular_file(file.status()) &&
-         boost::algorithm::to_lower_copy(file.path().extension().string()) ==
-           ext::pal)
+    const helpers::case_insensitive_path_index
+      usage_pals_dir_index(usage_pals_dir);
+
+    const std::vector<boost::filesystem::path> files =
+      helpers::get_files_with_ext(source_dir, ext::pal);
+    helpers::process_files(
+      files,
+      helpers::get_jobs_num(options[option::name::jobs].as<std::size_t>()),
+      [&](std::size_t, const boost::filesystem::path &file)
       {
         std::string orig_pal =
           helpers::read_file(
-            file.path(),
+            file,
             helpers::file_flag::binary | helpers::file_flag::read_all,
             0,
             0,
@@ -56,9 +59,8 @@ void remove_not_used_pal_mode(
             option::name::source_dir);
 
         boost::filesystem::path usage_pal_file =
-          helpers::filepath_case_insensitive_part_get(
-            usage_pals_dir,
-            file.path().stem().string() + ext::pal);
+          usage_pals_dir_index.get(
+            file.stem().string() + ext::pal);
         std::string usage_pal =
           helpers::read_file(
             usage_pal_file,
@@ -94,7 +96,7 @@ void remove_not_used_pal_mode(
 
         boost::filesystem::path file_to_save = output_dir;
         file_to_save.append(
-          boost::algorithm::to_lower_copy(file.path().stem().string()) +
+          boost::algorithm::to_lower_copy(file.stem().string()) +
             ext::pal,
           boost::filesystem::path::codecvt());
         helpers::save_file(file_to_save,
@@ -104,15 +106,14 @@ void remove_not_used_pal_mode(
 
         boost::filesystem::path file_to_save_unused = output_dir_unused;
         file_to_save_unused.append(
-          boost::algorithm::to_lower_copy(file.path().stem().string()) +
+          boost::algorithm::to_lower_copy(file.stem().string()) +
             ext::pal,
           boost::filesystem::path::codecvt());
         helpers::save_file(file_to_save_unused,
                            pal_unused,
                            helpers::file_flag::binary,
                            option::name::output_dir_unused);
-      }
-    }
+      });
   }
   catch(std::exception &)
   {
@@ -7,6 +7,8 @@
 #include "hex.hpp"
 #include "check_option.hpp"
 #include "file_operations.hpp"
+#include "thread_pool.hpp"
+#include "process_files.hpp"
 #include "check_pal_color_used.hpp"
 
 #include <boost/program_options.hpp>
@@ -32,12 +32,15 @@ void tga_merge_unused_pal_mode(
       helpers::get_directory(
         options[option::name::unused_pals_dir].as<std::string>(),
         option::name::unused_pals_dir);
-
-    for(const auto &file : boost::filesystem::directory_iterator(source_dir))
-    {
-      if(boost::filesystem::is_regular_file(file.status()) &&
-         boost::algorithm::to_lower_copy(file.path().extension().string()) ==
-           ext::tga)
+    const helpers::case_insensitive_path_index
+      unused_pals_dir_index(unused_pals_dir);
+
+    const std::vector<boost::filesystem::path> files =
+      helpers::get_files_with_ext(source_dir, ext::tga);
+    helpers::process_files(
+      files,
+      helpers::get_jobs_num(options[option::name::jobs].as<std::size_t>()),
+      [&](std::size_t, const boost::filesystem::path &file)
       {
         // Leaving extra 768 bytes at the beginning of
         // *.tga file string to move header there in case
@@ -45,7 +48,7 @@ void tga_merge_unused_pal_mode(
         std::size_t original_start_of_image = tga_default_pal_size;
         std::string bytes =
           helpers::read_file(
-            file.path(),
+            file,
             helpers::file_flag::binary | helpers::file_flag::read_all,
             original_start_of_image,
             0,
@@ -54,12 +57,15 @@ void tga_merge_unused_pal_mode(
 
         helpers::tga tga_image(bytes,
                                original_start_of_image,
-                               file.path().string());
+                               file.string());
+        helpers::tga_decompress(bytes,
+                                original_start_of_image,
+                                tga_image,
+                                file.string());
 
         boost::filesystem::path unused_pal_file =
-          helpers::filepath_case_insensitive_part_get(
-            unused_pals_dir,
-            file.path().stem().string() + ext::pal);
+          unused_pals_dir_index.get(
+            file.stem().string() + ext::pal);
         std::string unused_pal =
           helpers::read_file(
             unused_pal_file,
@@ -113,7 +119,7 @@ void tga_merge_unused_pal_mode(
            tga_default_colors_num_in_pal)
         {
           throw std::runtime_error(
-            "Number of palette colors of image " + file.path().string() +
+            "Number of palette colors of image " + file.string() +
             " is " + std::to_string(used_pal_colors) +
             ". Number of colors in palette " + unused_pal_file.string() +
             " is " + std::to_string(unused_pal_colors_num) +
@@ -124,13 +130,13 @@ void tga_merge_unused_pal_mode(
 
 
         // Creating merged palette.
-        // All color shifts of original palette
-        // are recorded to new_palette_pos_change_map
+        // Each color inserted before color of original palette
+        // shifts it and all colors after it.
+        // Shifts are recorded to new_palette_shift_starts
         // to change values of all bytes in image.
         std::string new_palette(tga_default_pal_size, '\0');
-        std::vector<unsigned char> new_palette_pos_change_map(
-          tga_default_colors_num_in_pal,
-          0);
+        std::array<std::size_t, helpers::byte_remap_table_size>
+          new_palette_shift_starts{};
         for(std::size_t tga_pal_color_num = 0,
               tga_pal_color_pos = tga_image.pal_start_pos,
               usage_pal_color_num = 0,
@@ -151,15 +157,9 @@ void tga_merge_unused_pal_mode(
               ++tga_pal_color_num;
               tga_pal_color_pos += 3;
             }
-            else
+            else if(tga_pal_color_num < tga_default_colors_num_in_pal)
             {
-              for(std::size_t cur_color_for_map = tga_pal_color_num,
-                    end_color_for_map = tga_default_colors_num_in_pal;
-                  cur_color_for_map != end_color_for_map;
-                  ++cur_color_for_map)
-              {
-                ++new_palette_pos_change_map[cur_color_for_map];
-              }
+              ++new_palette_shift_starts[tga_pal_color_num];
             }
           }
           else
@@ -214,24 +214,17 @@ void tga_merge_unused_pal_mode(
           new_palette);
 
         // Changing image bytes as needed.
-        for(std::size_t current_byte = tga_image.raw_bitmap_start_pos,
-              end_byte = tga_image.raw_bitmap_start_pos +
-                         tga_image.raw_bitmap_size;
-            current_byte != end_byte;
-            ++current_byte)
-        {
-          bytes[current_byte] =
-            static_cast<char>(
-              static_cast<unsigned char>(bytes[current_byte]) +
-              new_palette_pos_change_map[
-                static_cast<unsigned char>(bytes[current_byte])]);
-        }
+        helpers::byte_remap(
+          bytes.data() + tga_image.raw_bitmap_start_pos,
+          &bytes[tga_image.raw_bitmap_start_pos],
+          tga_image.raw_bitmap_size,
+          helpers::byte_remap_from_shift_starts(new_palette_shift_starts));
 
 
 
         boost::filesystem::path file_to_save = output_dir;
         file_to_save.append(
-          boost::algorithm::to_lower_copy(file.path().stem().string()) +
+          boost::algorithm::to_lower_copy(file.stem().string()) +
             ext::tga,
           boost::filesystem::path::codecvt());
         std::size_t size_of_file_to_write =
@@ -247,8 +240,7 @@ void tga_merge_unused_pal_mode(
           0,
           size_of_file_to_write,
           option::name::output_dir);
-      }
-    }
+      });
   }
   catch(std::exception &)
   {
@@ -7,8 +7,11 @@
 #include "hex.hpp"
 #include "check_option.hpp"
 #include "file_operations.hpp"
+#include "thread_pool.hpp"
+#include "process_files.hpp"
 #include "tga_class.hpp"
 #include "check_pal_color_used.hpp"
+#include "byte_remap.hpp"
 
 #include <boost/program_options.hpp>
 #include <boost/filesystem.hpp>
@@ -17,6 +20,7 @@
 #include <stdexcept>
 
 #include <iostream>
+#include <array>
 #include <string>
 #include <vector>
 
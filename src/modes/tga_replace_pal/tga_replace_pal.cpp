@@ -32,12 +32,14 @@ void tga_replace_pal_mode(
       helpers::get_directory(
         options[option::name::pal_dir].as<std::string>(),
         option::name::pal_dir);
-
-    for(const auto &file : boost::filesystem::directory_iterator(source_dir))
-    {
-      if(boost::filesystem::is_regular_file(file.status()) &&
-         boost::algorithm::to_lower_copy(file.path().extension().string()) ==
-           ext::tga)
+    const helpers::case_insensitive_path_index pal_dir_index(pal_dir);
+
+    const std::vector<boost::filesystem::path> files =
+      helpers::get_files_with_ext(source_dir, ext::tga);
+    helpers::process_files(
+      files,
+      helpers::get_jobs_num(options[option::name::jobs].as<std::size_t>()),
+      [&](std::size_t, const boost::filesystem::path &file)
       {
         // Leaving extra 768 bytes at the beginning of
         // *.tga file string to move header there in case
@@ -45,7 +47,7 @@ void tga_replace_pal_mode(
         std::size_t original_start_of_image = tga_default_pal_size;
         std::string bytes =
           helpers::read_file(
-            file.path(),
+            file,
             helpers::file_flag::binary | helpers::file_flag::read_all,
             original_start_of_image,
             0,
@@ -54,12 +56,15 @@ void tga_replace_pal_mode(
 
         helpers::tga tga_image(bytes,
                                original_start_of_image,
-                               file.path().string());
+                               file.string());
+        helpers::tga_decompress(bytes,
+                                original_start_of_image,
+                                tga_image,
+                                file.string());
 
         boost::filesystem::path new_pal_file =
-          helpers::filepath_case_insensitive_part_get(
-            pal_dir,
-            file.path().stem().string() + ext::pal);
+          pal_dir_index.get(
+            file.stem().string() + ext::pal);
         std::string new_pal =
           helpers::read_file(
             new_pal_file,
@@ -103,7 +108,7 @@ void tga_replace_pal_mode(
 
         boost::filesystem::path file_to_save = output_dir;
         file_to_save.append(
-          boost::algorithm::to_lower_copy(file.path().stem().string()) +
+          boost::algorithm::to_lower_copy(file.stem().string()) +
             ext::tga,
           boost::filesystem::path::codecvt());
         std::size_t size_of_file_to_write =
@@ -119,8 +124,7 @@ void tga_replace_pal_mode(
           0,
           size_of_file_to_write,
           option::name::output_dir);
-      }
-    }
+      });
   }
   catch(std::exception &)
   {
@@ -37,11 +37,11 @@ void tga_to_bmp_mode(const boost::program_options::variables_map options)
         options[option::name::output_dir].as<std::string>(),
         option::name::output_dir);
 
-    std::string compare_map;
+    helpers::byte_remap_table compare_map;
     boost::filesystem::path output_dir_through_map;
     if(options[option::name::items_bmp].as<bool>())
     {
-      compare_map =
+      std::string compare_map_bytes =
         helpers::read_file(
           options[option::name::map].as<std::string>(),
           helpers::file_flag::binary | helpers::file_flag::read_all,
@@ -49,28 +49,40 @@ void tga_to_bmp_mode(const boost::program_options::variables_map options)
           0,
           helpers::read_all_dummy_size,
           option::name::map);
+      if(compare_map_bytes.size() < helpers::byte_remap_table_size)
+      {
+        throw std::runtime_error(
+          option::name::map + " file " +
+          options[option::name::map].as<std::string>() + " has " +
+          std::to_string(compare_map_bytes.size()) + " bytes while " +
+          std::to_string(helpers::byte_remap_table_size) +
+          " bytes are expected.");
+      }
+      compare_map = helpers::byte_remap_from_bytes(compare_map_bytes);
       output_dir_through_map =
         helpers::get_directory(
           options[option::name::output_dir_through_map].as<std::string>(),
           option::name::output_dir_through_map);
     }
 
-    for(const auto &file : boost::filesystem::directory_iterator(source_dir))
-    {
-      if(boost::filesystem::is_regular_file(file.status()) &&
-         boost::algorithm::to_lower_copy(file.path().extension().string()) ==
-           ext::tga)
+    const std::vector<boost::filesystem::path> files =
+      helpers::get_files_with_ext(source_dir, ext::tga);
+    helpers::process_files(
+      files,
+      helpers::get_jobs_num(options[option::name::jobs].as<std::size_t>()),
+      [&](std::size_t, const boost::filesystem::path &file)
       {
         std::string bytes =
           helpers::read_file(
-            file.path(),
+            file,
             helpers::file_flag::binary | helpers::file_flag::read_all,
             0,
             0,
             helpers::read_all_dummy_size,
             option::name::source_dir);
 
-        helpers::tga tga_image(bytes, 0, file.path().string());
+        helpers::tga tga_image(bytes, 0, file.string());
+        helpers::tga_decompress(bytes, 0, tga_image, file.string());
 
         std::size_t vangers_bmp_size =
           vangers_bmp_coords_size + tga_image.raw_bitmap_size;
@@ -90,91 +102,37 @@ void tga_to_bmp_mode(const boost::program_options::variables_map options)
         {
           // Changing all bytes with value
           // which is not used by palette into null bytes.
-          std::vector<int> used_characters(tga_default_colors_num_in_pal, 0);
+          helpers::byte_remap_table null_unused_colors_map =
+            helpers::byte_remap_identity();
           for(std::size_t current_color_num = 0,
-                current_color_pos = tga_image.pal_start_pos,
-                end_color = real_start_of_bmp_no_coords;
-              current_color_pos != end_color;
+                current_color_pos = tga_image.pal_start_pos;
+              current_color_num != helpers::byte_remap_table_size;
               ++current_color_num,
                 current_color_pos += 3)
           {
-            if(helpers::check_pal_color_used(current_color_pos, bytes))
+            if(current_color_num >= tga_image.colors_num ||
+               !helpers::check_pal_color_used(current_color_pos, bytes))
             {
-              ++used_characters[current_color_num];
-            }
-          }
-          for(std::size_t current_byte = real_start_of_bmp_no_coords,
-                end_of_bitmap = real_start_of_bmp + vangers_bmp_size;
-              current_byte != end_of_bitmap;
-              ++current_byte)
-          {
-            std::size_t current_color_to_check =
-              static_cast<std::size_t>(
-                static_cast<unsigned char>(bytes[current_byte]));
-            if(!used_characters[current_color_to_check])
-            {
-              bytes[current_byte] = '\0';
+              null_unused_colors_map[current_color_num] = 0;
             }
           }
+          helpers::byte_remap(bytes.data() + real_start_of_bmp_no_coords,
+                              &bytes[real_start_of_bmp_no_coords],
+                              tga_image.raw_bitmap_size,
+                              null_unused_colors_map);
 
 
           // Turning if needed.
-          std::string tga_image_descriptor =
-            bytes.substr(tga_image_specification_image_descriptor_pos,
-                         tga_image_specification_image_descriptor_str.size());
-          // Checking whether image descriptor is expected by Vangers.
-          if(tga_image_descriptor !=
-             tga_image_specification_image_descriptor_str)
-          {
-            // Checking whether bit 4 is off counting from 0.
-            // If so, flip horizontally.
-            if(tga_image_descriptor[0] & '\x10')
-            {
-              std::size_t row_start_pos = real_start_of_bmp_no_coords;
-              for(std::size_t current_y = 0;
-                  current_y != tga_image.height;
-                  ++current_y)
-              {
-                for(std::size_t current_x = 0, max_x = tga_image.width / 2;
-                    current_x != max_x;
-                    ++current_x)
-                {
-                  std::size_t byte_to_flip_1_pos = row_start_pos + current_x;
-                  std::size_t byte_to_flip_2_pos =
-                    row_start_pos + tga_image.width - 1 - current_x;
-                  char temp = bytes[byte_to_flip_1_pos];
-                  bytes[byte_to_flip_1_pos] = bytes[byte_to_flip_2_pos];
-                  bytes[byte_to_flip_2_pos] = temp;
-                }
-                row_start_pos += tga_image.width;
-              }
-            }
-            // Checking whether bit 5 is off counting from 0.
-            // If so, flip vertically.
-            if(!(tga_image_descriptor[0] & '\x20'))
-            {
-              std::size_t column_start_pos = real_start_of_bmp_no_coords;
-              for(std::size_t current_x = 0;
-                  current_x != tga_image.width;
-                  ++current_x)
-              {
-                for(std::size_t current_y = 0, max_y = tga_image.height / 2;
-                    current_y != max_y;
-                    ++current_y)
-                {
-                  std::size_t byte_to_flip_1_pos =
-                    column_start_pos + current_y * tga_image.width;
-                  std::size_t byte_to_flip_2_pos =
-                    column_start_pos +
-                    (tga_image.height - 1 - current_y) * tga_image.width;
-                  char temp = bytes[byte_to_flip_1_pos];
-                  bytes[byte_to_flip_1_pos] = bytes[byte_to_flip_2_pos];
-                  bytes[byte_to_flip_2_pos] = temp;
-                }
-                ++column_start_pos;
-              }
-            }
-          }
+          // Image descriptor expected by Vangers means
+          // that rows are stored from top to bottom and from left to right.
+          helpers::orient_image(
+            &bytes[real_start_of_bmp_no_coords],
+            tga_image.width,
+            tga_image.height,
+            static_cast<unsigned char>(
+              bytes[tga_image_specification_image_descriptor_pos]),
+            static_cast<unsigned char>(
+              tga_image_specification_image_descriptor_str[0]));
         }
 
         bytes.replace(real_start_of_bmp,
@@ -185,7 +143,7 @@ void tga_to_bmp_mode(const boost::program_options::variables_map options)
 
         boost::filesystem::path file_to_save = output_dir;
         file_to_save.append(
-          boost::algorithm::to_lower_copy(file.path().stem().string()) +
+          boost::algorithm::to_lower_copy(file.stem().string()) +
             ext::bmp,
           boost::filesystem::path::codecvt());
         helpers::write_to_file(
@@ -207,21 +165,14 @@ void tga_to_bmp_mode(const boost::program_options::variables_map options)
                                vangers_bmp_coords_size,
                                tga_image.width_height);
 
-          for(std::size_t current_byte = real_start_of_bmp_no_coords,
-                current_mapped_byte = vangers_bmp_coords_size,
-                mapped_bytes_size = vangers_bmp_size;
-              current_mapped_byte != mapped_bytes_size;
-              ++current_byte,
-                ++current_mapped_byte)
-          {
-            mapped_bytes[current_mapped_byte] =
-              compare_map[static_cast<std::size_t>(
-                static_cast<unsigned char>(bytes[current_byte]))];
-          }
+          helpers::byte_remap(bytes.data() + real_start_of_bmp_no_coords,
+                              &mapped_bytes[vangers_bmp_coords_size],
+                              tga_image.raw_bitmap_size,
+                              compare_map);
 
           boost::filesystem::path file_to_save_mapped = output_dir_through_map;
           file_to_save_mapped.append(
-            boost::algorithm::to_lower_copy(file.path().stem().string()) +
+            boost::algorithm::to_lower_copy(file.stem().string()) +
               ext::bmp,
             boost::filesystem::path::codecvt());
           helpers::save_file(file_to_save_mapped,
@@ -229,8 +180,7 @@ void tga_to_bmp_mode(const boost::program_options::variables_map options)
                              helpers::file_flag::binary,
                              option::name::output_dir_through_map);
         }
-      }
-    }
+      });
   }
   catch(std::exception &)
   {
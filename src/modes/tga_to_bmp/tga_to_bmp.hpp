@@ -7,8 +7,12 @@
 #include "hex.hpp"
 #include "check_option.hpp"
 #include "file_operations.hpp"
+#include "thread_pool.hpp"
+#include "process_files.hpp"
 #include "tga_class.hpp"
 #include "check_pal_color_used.hpp"
+#include "byte_remap.hpp"
+#include "image_orientation.hpp"
 
 #include <boost/program_options.hpp>
 
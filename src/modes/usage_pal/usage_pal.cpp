@@ -8,17 +8,17 @@ namespace tractor_converter{
 
 void usage_pal_mode_save_output_readable(
   boost::filesystem::path file,
-  const std::vector<int> &used_characters,
+  const helpers::byte_histogram &used_characters,
   const std::string &file_name_error)
 {
   std::string used_bytes_map_readable;
   // 256 bytes total *
-  //   (2 size of hex of byte + 1 space + 10 max int + 2 newline) +
-  // 13 "Used colors: " string + 10 max int
+  //   (2 size of hex of byte + 1 space + 20 max size_t + 2 newline) +
+  // 13 "Used colors: " string + 20 max size_t
   used_bytes_map_readable.reserve(
     tga_default_colors_num_in_pal *
-      (2 + 1 + 10 + 2) +
-    13 + 10);
+      (2 + 1 + 20 + 2) +
+    13 + 20);
 
   std::size_t used_colors = 0;
   for(std::size_t current_byte = 0;
@@ -47,7 +47,7 @@ void usage_pal_mode_save_output_readable(
 
 void usage_pal_mode_save_output_not_readable(
   boost::filesystem::path file,
-  const std::vector<int> &used_characters,
+  const helpers::byte_histogram &used_characters,
   const std::string &file_name_error)
 {
   std::string used_bytes_map;
@@ -78,7 +78,7 @@ void usage_pal_mode_save_output_not_readable(
 
 void usage_pal_mode_save_output(
   boost::filesystem::path file,
-  const std::vector<int> &used_characters,
+  const helpers::byte_histogram &used_characters,
   bool readable_output,
   const std::string &file_name_error)
 {
@@ -138,62 +138,91 @@ void usage_pal_mode(const boost::program_options::variables_map options)
           option::name::output_dir);
     }
 
-    std::vector<int> used_characters(tga_default_colors_num_in_pal, 0);
-
-    for(const auto &file : boost::filesystem::directory_iterator(source_dir))
-    {
-      if(boost::filesystem::is_regular_file(file.status()) &&
-         boost::algorithm::to_lower_copy(file.path().extension().string()) ==
-           ext::bmp)
+    const std::vector<boost::filesystem::path> files =
+      helpers::get_files_with_ext(source_dir, ext::bmp);
+    // Files are counted in parallel.
+    // For single output, each running task counts into partial histogram
+    // which is not used by other tasks at the same time,
+    // so there are no more partial histograms than threads.
+    // Partial histograms are summed once after all files are done.
+    std::vector<std::unique_ptr<helpers::byte_histogram>> partials;
+    std::vector<helpers::byte_histogram *> free_partials;
+    std::mutex partials_mutex;
+    helpers::process_files(
+      files,
+      helpers::get_jobs_num(options[option::name::jobs].as<std::size_t>()),
+      [&](std::size_t, const boost::filesystem::path &file)
       {
-        std::string bmp_map;
+        helpers::byte_histogram file_used_characters{};
+        helpers::byte_histogram *used_characters = &file_used_characters;
+        if(!options[option::name::usage_pal_for_each_file].as<bool>())
+        {
+          std::lock_guard<std::mutex> lock(partials_mutex);
+          if(free_partials.empty())
+          {
+            partials.emplace_back(new helpers::byte_histogram{});
+            free_partials.push_back(partials.back().get());
+          }
+          used_characters = free_partials.back();
+          free_partials.pop_back();
+        }
+
+        const helpers::file_view bmp_file(file,
+                                          option::name::source_dir);
         // First 4 bytes indicate width and height of *.bmp file,
         // so they are skipped.
-        bmp_map =
-          helpers::read_file(
-            file.path(),
-            helpers::file_flag::binary | helpers::file_flag::read_all,
-            0,
-            4,
-            helpers::read_all_dummy_size,
-            option::name::source_dir);
-
-        for(char& bmp_byte : bmp_map)
+        const char *bmp_map_begin = bmp_file.begin();
+        if(bmp_file.size() > vangers_bmp_coords_size)
+        {
+          bmp_map_begin += vangers_bmp_coords_size;
+        }
+        else
         {
-          ++used_characters[
-            static_cast<std::size_t>(static_cast<unsigned char>(bmp_byte))];
+          bmp_map_begin = bmp_file.end();
         }
 
+        helpers::byte_histogram_add(bmp_map_begin,
+                                    bmp_file.end() - bmp_map_begin,
+                                    *used_characters);
+
         if(options[option::name::usage_pal_for_each_file].as<bool>())
         {
           boost::filesystem::path file_to_save = output_dir;
           if(options[option::name::readable_output].as<bool>())
           {
             file_to_save.append(
-              boost::algorithm::to_lower_copy(file.path().stem().string()) +
+              boost::algorithm::to_lower_copy(file.stem().string()) +
                 ".txt",
               boost::filesystem::path::codecvt());
           }
           else
           {
             file_to_save.append(
-              boost::algorithm::to_lower_copy(file.path().stem().string()) +
+              boost::algorithm::to_lower_copy(file.stem().string()) +
                 ext::pal,
               boost::filesystem::path::codecvt());
           }
           usage_pal_mode_save_output(
             file_to_save,
-            used_characters,
+            *used_characters,
             options[option::name::readable_output].as<bool>(),
             option::name::output_dir);
-          // Delete all values.
-          std::fill(used_characters.begin(), used_characters.end(), 0);
         }
-      }
-    }
+        else
+        {
+          std::lock_guard<std::mutex> lock(partials_mutex);
+          free_partials.push_back(used_characters);
+        }
+      });
 
     if(!options[option::name::usage_pal_for_each_file].as<bool>())
     {
+      helpers::byte_histogram used_characters{};
+      for(const auto &partial : partials)
+      {
+        helpers::byte_histogram_merge(used_characters, *partial);
+      }
+
       boost::filesystem::path file_to_save =
         boost::filesystem::weakly_canonical(
           options[option::name::output_file].as<std::string>());
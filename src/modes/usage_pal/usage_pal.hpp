@@ -7,6 +7,9 @@
 #include "hex.hpp"
 #include "check_option.hpp"
 #include "file_operations.hpp"
+#include "thread_pool.hpp"
+#include "process_files.hpp"
+#include "byte_histogram.hpp"
 
 #include <boost/program_options.hpp>
 #include <boost/filesystem.hpp>
@@ -15,9 +18,12 @@
 #include <stdexcept>
 
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include <mutex>
+
 
 
 namespace tractor_converter{
@@ -6,10 +6,35 @@ namespace tractor_converter{
 
 
 
+m3d_to_obj_job::m3d_to_obj_job(
+  const helpers::vangers_3d_paths_game_dir::io_paths &io_paths_arg)
+: helpers::model_job(io_paths_arg),
+  scale_size(0.0)
+{
+}
+
+
+
+void finish_m3d_to_obj_jobs(const std::vector<m3d_to_obj_job> &jobs)
+{
+  helpers::finish_model_jobs(
+    jobs,
+    [](const m3d_to_obj_job &job)
+    {
+      if(job.exception)
+      {
+        std::cout.flush();
+        std::rethrow_exception(job.exception);
+      }
+    });
+}
+
+
+
 double scale_from_map(
   const std::unordered_map<std::string, double> &scale_sizes,
   const boost::filesystem::path &to_lookup_path,
-  const boost::filesystem::path &input_game_dir_root,
+  const helpers::case_insensitive_path_index &input_game_dir_index,
   const std::string &input_file_name_error,
   scale_from_map_type type,
   double default_scale)
@@ -35,25 +60,26 @@ double scale_from_map(
     }
 
     boost::filesystem::path bogus_file =
-      helpers::filepath_case_insensitive_part_get(input_game_dir_root,
-                                                  bogus_file_rel_root);
+      input_game_dir_index.get(bogus_file_rel_root);
     if(bogus_file.string().size())
     {
-      std::cout << '\n';
-      std::cout << (input_file_name_error + " file " + bogus_file.string() +
-        " has unspecified scale_size for " + to_lookup_path.string() +
-        " file. Default scale " + std::to_string(default_scale) +
-        " is used.") << '\n';
+      helpers::thread_log() << '\n';
+      helpers::thread_log() <<
+        (input_file_name_error + " file " + bogus_file.string() +
+         " has unspecified scale_size for " + to_lookup_path.string() +
+         " file. Default scale " + std::to_string(default_scale) +
+         " is used.") << '\n';
       return default_scale;
     }
     else
     {
-      bogus_file = input_game_dir_root / bogus_file_rel_root;
-      std::cout << '\n';
-      std::cout << (input_file_name_error + " file " + bogus_file.string() +
-        " doesn't exist but needed to provide scale_size for " +
-        to_lookup_path.string() + " file. Default scale " +
-        std::to_string(default_scale) + " is used.") << '\n';
+      bogus_file = input_game_dir_index.root() / bogus_file_rel_root;
+      helpers::thread_log() << '\n';
+      helpers::thread_log() <<
+        (input_file_name_error + " file " + bogus_file.string() +
+         " doesn't exist but needed to provide scale_size for " +
+         to_lookup_path.string() + " file. Default scale " +
+         std::to_string(default_scale) + " is used.") << '\n';
       return default_scale;
     }
   }
@@ -129,6 +155,16 @@ void vangers_3d_model_to_obj_mode(
       m3d_to_obj_flags |=
         helpers::m3d_to_obj_flag::use_custom_J_by_default;
     }
+    bool use_obj_binary_cache =
+      options[option::name::obj_binary_cache].as<bool>();
+    if(use_obj_binary_cache)
+    {
+      m3d_to_obj_flags |=
+        helpers::m3d_to_obj_flag::use_obj_binary_cache;
+    }
+
+    std::size_t jobs_num =
+      helpers::get_jobs_num(options[option::name::jobs].as<std::size_t>());
 
 
 
@@ -147,11 +183,13 @@ void vangers_3d_model_to_obj_mode(
     {
       // Getting weapon attachment point model to insert into weapon model.
       weapon_attachment_point_model =
-        helpers::raw_obj_to_volInt_model(
+        helpers::raw_obj_to_volInt_model_cached(
           weapon_attachment_point_file,
           option::name::weapon_attachment_point_file,
           c3d::c3d_type::regular,
-          c3d::color::string_to_id::attachment_point);
+          c3d::color::string_to_id::attachment_point,
+          use_obj_binary_cache,
+          jobs_num);
       weapon_attachment_point_model_ptr = &weapon_attachment_point_model;
 
       if(!weapon_attachment_point_model_ptr->find_ref_points())
@@ -190,11 +228,13 @@ void vangers_3d_model_to_obj_mode(
       // Getting ghost wheel model to insert
       // in place of wheels with no polygons.
       ghost_wheel_model =
-        helpers::raw_obj_to_volInt_model(
+        helpers::raw_obj_to_volInt_model_cached(
           ghost_wheel_file,
           option::name::ghost_wheel_file,
           c3d::c3d_type::regular,
-          c3d::color::string_to_id::wheel);
+          c3d::color::string_to_id::wheel,
+          use_obj_binary_cache,
+          jobs_num);
       ghost_wheel_model_ptr = &ghost_wheel_model;
       ghost_wheel_model.move_coord_system_to_center();
     }
@@ -218,11 +258,13 @@ void vangers_3d_model_to_obj_mode(
       {
         // Getting center of mass model to mark extracted center of mass.
         center_of_mass_model =
-          helpers::raw_obj_to_volInt_model(
+          helpers::raw_obj_to_volInt_model_cached(
             center_of_mass_file,
             option::name::center_of_mass_file,
             c3d::c3d_type::regular,
-            c3d::color::string_to_id::center_of_mass);
+            c3d::color::string_to_id::center_of_mass,
+            use_obj_binary_cache,
+            jobs_num);
         center_of_mass_model_ptr = &center_of_mass_model;
 
         if(!center_of_mass_model_ptr->find_ref_points())
@@ -282,17 +324,21 @@ void vangers_3d_model_to_obj_mode(
     // Getting list of paths with *.prm, *.m3d and *.a3d files.
     for(auto &&game_dir : vangers_game_dirs)
     {
+      // Walking game directory only once since there are
+      // many case insensitive lookups inside of it.
+      game_dir.second.root_input_index =
+        helpers::case_insensitive_path_index(game_dir.second.root.input);
+
       boost::filesystem::path resource_folder_name(folder::resource);
       boost::filesystem::path m3d_folder_name(folder::m3d);
 
       boost::filesystem::path input_resource =
-        helpers::filepath_case_insensitive_part_get(game_dir.second.root.input,
-                                                    resource_folder_name);
+        game_dir.second.root_input_index.get(resource_folder_name);
       boost::filesystem::path output_resource =
         game_dir.second.root.output / resource_folder_name;
       boost::filesystem::path input_resource_m3d =
-        helpers::filepath_case_insensitive_part_get(input_resource,
-                                                    m3d_folder_name);
+        game_dir.second.root_input_index.get(resource_folder_name /
+                                             m3d_folder_name);
       boost::filesystem::path output_resource_m3d =
         output_resource / m3d_folder_name;
 
@@ -385,6 +431,7 @@ void vangers_3d_model_to_obj_mode(
     // Converting files for each game directory.
     // It is assumed that each game directory has its own
     // *.prm parameters and *.m3d weapons files.
+    helpers::thread_pool pool(jobs_num);
     for(const auto &game_dir : vangers_game_dirs)
     {
       std::unordered_map<std::string, double> non_mechos_scale_sizes =
@@ -393,41 +440,69 @@ void vangers_3d_model_to_obj_mode(
                                                option::name::source_dir,
                                                option::name::output_dir);
 
+      std::vector<m3d_to_obj_job> prm_jobs =
+        helpers::get_model_jobs<m3d_to_obj_job>(game_dir.second.mechous_prm);
+      helpers::add_model_jobs(
+        pool,
+        prm_jobs,
+        [&](m3d_to_obj_job &job)
+        {
+          job.scale_size =
+            helpers::read_scale_and_copy_prm(job.io_paths->input,
+                                             job.io_paths->output,
+                                             option::name::source_dir,
+                                             option::name::output_dir);
+        });
+      pool.wait();
+      finish_m3d_to_obj_jobs(prm_jobs);
+
       std::unordered_map<std::string, double> mechos_scale_sizes;
-      for(const auto &prm_io_paths : game_dir.second.mechous_prm)
+      for(const auto &job : prm_jobs)
       {
         std::string m3d_filename_lowercase =
           boost::algorithm::to_lower_copy(
-            prm_io_paths.second.input.stem().string());
-        mechos_scale_sizes[m3d_filename_lowercase] =
-          helpers::read_scale_and_copy_prm(prm_io_paths.second.input,
-                                           prm_io_paths.second.output,
-                                           option::name::source_dir,
-                                           option::name::output_dir);
+            job.io_paths->input.stem().string());
+        mechos_scale_sizes[m3d_filename_lowercase] = job.scale_size;
       }
 
 
+      // Weapons must be extracted first
+      // since mechos need example weapon model.
+      std::vector<m3d_to_obj_job> weapon_jobs =
+        helpers::get_model_jobs<m3d_to_obj_job>(game_dir.second.weapon_m3d);
+      helpers::add_model_jobs(
+        pool,
+        weapon_jobs,
+        [&](m3d_to_obj_job &job)
+        {
+          double scale_size = scale_from_map(non_mechos_scale_sizes,
+                                             job.io_paths->input,
+                                             game_dir.second.root_input_index,
+                                             option::name::source_dir,
+                                             scale_from_map_type::non_mechos,
+                                             default_scale);
+
+          job.model =
+            helpers::weapon_m3d_to_wavefront_objs(
+              job.io_paths->input,
+              job.io_paths->output,
+              option::name::source_dir,
+              option::name::output_dir,
+              weapon_attachment_point_model_ptr,
+              center_of_mass_model_ptr,
+              scale_size,
+              wavefront_float_precision,
+              m3d_to_obj_flags);
+        });
+      pool.wait();
+      finish_m3d_to_obj_jobs(weapon_jobs);
+
       std::unordered_map<std::string, volInt::polyhedron> weapons_models;
-      for(const auto &m3d_io_paths : game_dir.second.weapon_m3d)
+      weapons_models.reserve(weapon_jobs.size());
+      for(auto &&job : weapon_jobs)
       {
-        double scale_size = scale_from_map(non_mechos_scale_sizes,
-                                           m3d_io_paths.second.input,
-                                           game_dir.second.root.input,
-                                           option::name::source_dir,
-                                           scale_from_map_type::non_mechos,
-                                           default_scale);
-
-        weapons_models[m3d_io_paths.second.input.stem().string()] =
-          helpers::weapon_m3d_to_wavefront_objs(
-            m3d_io_paths.second.input,
-            m3d_io_paths.second.output,
-            option::name::source_dir,
-            option::name::output_dir,
-            weapon_attachment_point_model_ptr,
-            center_of_mass_model_ptr,
-            scale_size,
-            wavefront_float_precision,
-            m3d_to_obj_flags);
+        weapons_models[job.io_paths->input.stem().string()] =
+          std::move(job.model);
       }
 
       volInt::polyhedron *mechos_weapon_model_ptr;
@@ -454,69 +529,93 @@ void vangers_3d_model_to_obj_mode(
       }
 
 
-      for(const auto &m3d_io_paths : game_dir.second.mechous_m3d)
-      {
-        double scale_size = scale_from_map(mechos_scale_sizes,
-                                           m3d_io_paths.second.input,
-                                           game_dir.second.root.input,
-                                           option::name::source_dir,
-                                           scale_from_map_type::mechos,
-                                           default_scale);
-
-        helpers::mechos_m3d_to_wavefront_objs(
-          m3d_io_paths.second.input,
-          m3d_io_paths.second.output,
-          option::name::source_dir,
-          option::name::output_dir,
-          mechos_weapon_model_ptr,
-          ghost_wheel_model_ptr,
-          center_of_mass_model_ptr,
-          scale_size,
-          wavefront_float_precision,
-          m3d_to_obj_flags);
-      }
+      // Mechos, animated and other models don't depend on each other
+      // so they are extracted all at once.
+      // Shared models are only read while extracting.
+      std::vector<m3d_to_obj_job> mechos_jobs =
+        helpers::get_model_jobs<m3d_to_obj_job>(game_dir.second.mechous_m3d);
+      helpers::add_model_jobs(
+        pool,
+        mechos_jobs,
+        [&](m3d_to_obj_job &job)
+        {
+          double scale_size = scale_from_map(mechos_scale_sizes,
+                                             job.io_paths->input,
+                                             game_dir.second.root_input_index,
+                                             option::name::source_dir,
+                                             scale_from_map_type::mechos,
+                                             default_scale);
+
+          helpers::mechos_m3d_to_wavefront_objs(
+            job.io_paths->input,
+            job.io_paths->output,
+            option::name::source_dir,
+            option::name::output_dir,
+            mechos_weapon_model_ptr,
+            ghost_wheel_model_ptr,
+            center_of_mass_model_ptr,
+            scale_size,
+            wavefront_float_precision,
+            m3d_to_obj_flags);
+        });
 
 
-      for(const auto &a3d_io_paths : game_dir.second.animated_a3d)
-      {
-        double scale_size = scale_from_map(non_mechos_scale_sizes,
-                                           a3d_io_paths.second.input,
-                                           game_dir.second.root.input,
-                                           option::name::source_dir,
-                                           scale_from_map_type::non_mechos,
-                                           default_scale);
-
-        helpers::animated_a3d_to_wavefront_objs(
-          a3d_io_paths.second.input,
-          a3d_io_paths.second.output,
-          option::name::source_dir,
-          option::name::output_dir,
-          center_of_mass_model_ptr,
-          scale_size,
-          wavefront_float_precision,
-          m3d_to_obj_flags);
-      }
+      std::vector<m3d_to_obj_job> animated_jobs =
+        helpers::get_model_jobs<m3d_to_obj_job>(game_dir.second.animated_a3d);
+      helpers::add_model_jobs(
+        pool,
+        animated_jobs,
+        [&](m3d_to_obj_job &job)
+        {
+          double scale_size = scale_from_map(non_mechos_scale_sizes,
+                                             job.io_paths->input,
+                                             game_dir.second.root_input_index,
+                                             option::name::source_dir,
+                                             scale_from_map_type::non_mechos,
+                                             default_scale);
+
+          helpers::animated_a3d_to_wavefront_objs(
+            job.io_paths->input,
+            job.io_paths->output,
+            option::name::source_dir,
+            option::name::output_dir,
+            center_of_mass_model_ptr,
+            scale_size,
+            wavefront_float_precision,
+            m3d_to_obj_flags);
+        });
 
 
-      for(const auto &m3d_io_paths : game_dir.second.other_m3d)
-      {
-        double scale_size = scale_from_map(non_mechos_scale_sizes,
-                                           m3d_io_paths.second.input,
-                                           game_dir.second.root.input,
-                                           option::name::source_dir,
-                                           scale_from_map_type::non_mechos,
-                                           default_scale);
-
-        helpers::other_m3d_to_wavefront_objs(
-          m3d_io_paths.second.input,
-          m3d_io_paths.second.output,
-          option::name::source_dir,
-          option::name::output_dir,
-          center_of_mass_model_ptr,
-          scale_size,
-          wavefront_float_precision,
-          m3d_to_obj_flags);
-      }
+      std::vector<m3d_to_obj_job> other_jobs =
+        helpers::get_model_jobs<m3d_to_obj_job>(game_dir.second.other_m3d);
+      helpers::add_model_jobs(
+        pool,
+        other_jobs,
+        [&](m3d_to_obj_job &job)
+        {
+          double scale_size = scale_from_map(non_mechos_scale_sizes,
+                                             job.io_paths->input,
+                                             game_dir.second.root_input_index,
+                                             option::name::source_dir,
+                                             scale_from_map_type::non_mechos,
+                                             default_scale);
+
+          helpers::other_m3d_to_wavefront_objs(
+            job.io_paths->input,
+            job.io_paths->output,
+            option::name::source_dir,
+            option::name::output_dir,
+            center_of_mass_model_ptr,
+            scale_size,
+            wavefront_float_precision,
+            m3d_to_obj_flags);
+        });
+
+
+      pool.wait();
+      finish_m3d_to_obj_jobs(mechos_jobs);
+      finish_m3d_to_obj_jobs(animated_jobs);
+      finish_m3d_to_obj_jobs(other_jobs);
 
       boost::filesystem::path where_to_save_mtl;
       try
@@ -8,10 +8,12 @@
 #include "hex.hpp"
 #include "check_option.hpp"
 #include "file_operations.hpp"
+#include "thread_pool.hpp"
+#include "thread_log.hpp"
+#include "model_jobs.hpp"
 #include "vangers_3d_model_operations.hpp"
 #include "m3d_to_wavefront_obj_operations.hpp"
-
-#include "tiny_obj_loader.h"
+#include "volInt_cache_operations.hpp"
 
 #include <boost/program_options.hpp>
 #include <boost/filesystem.hpp>
@@ -31,11 +33,32 @@ namespace tractor_converter{
 
 
 
+// Extraction of single model.
+// Messages are saved per model and printed later
+// so models extracted in parallel don't mix their output.
+struct m3d_to_obj_job : helpers::model_job
+{
+  m3d_to_obj_job(
+    const helpers::vangers_3d_paths_game_dir::io_paths &io_paths_arg);
+
+  // Used only for weapons.
+  volInt::polyhedron model;
+  // Used only for *.prm files.
+  double scale_size;
+};
+
+// Must be called after all jobs are done.
+// Prints messages in the same order as serial extraction would
+// and rethrows exception of the first failed job.
+void finish_m3d_to_obj_jobs(const std::vector<m3d_to_obj_job> &jobs);
+
+
+
 enum class scale_from_map_type{mechos, non_mechos};
 double scale_from_map(
   const std::unordered_map<std::string, double> &scale_sizes,
   const boost::filesystem::path &to_lookup_path,
-  const boost::filesystem::path &input_game_dir_root,
+  const helpers::case_insensitive_path_index &input_game_dir_index,
   const std::string &input_file_name_error,
   scale_from_map_type type,
   double default_scale);